@@ -0,0 +1,223 @@
+/*
+scp, The sequential clique percolation algorithm.
+Copyright (C) 2011  Aalto University
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+/*
+Benchmark of the (k-1)-clique hash used by the sequential clique percolation.
+
+The edge list is streamed in the same order as k_clique does it, and for every
+edge the new k-cliques are found. Their (k-1)-subcliques are looked up and
+inserted exactly like kCommunitiesFind does, once into the chained listCliqueHash
+(the old table) and once into the open addressing cliqueHash. Both tables are
+finally compared key by key.
+
+With -t only one of the tables is filled, and the peak RSS of the process is
+reported before and after it, so that the memory of each table can be compared
+in separate runs.
+*/
+
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+
+#include "../cliqueHash.h"
+#include "listCliqueHash.h"
+
+#define HELPSTR "Usage: ./cliqueHashBench [inputfile] [options]\n\
+Options:\n\
+\t-k=[clique size] : The size of the clique (default 4).\n\
+\t-t=[list|flat] : Fill only listCliqueHash or cliqueHash and report the peak RSS.\n"
+
+
+// extends 'current' with nodes of 'candidates' until it has k nodes
+static void extendCliques(const NetType & net, std::vector<size_t> & current, const std::vector<size_t> & candidates, const size_t k, std::vector<std::vector<size_t> > & cliques)
+{
+    if (current.size() == k)
+    {
+        cliques.push_back(current);
+        return;
+    }
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        std::vector<size_t> next;
+        for (size_t j = i + 1; j < candidates.size(); j++)
+            if (net(candidates[i])[candidates[j]] > 0)
+                next.push_back(candidates[j]);
+        current.push_back(candidates[i]);
+        extendCliques(net, current, next, k, cliques);
+        current.pop_back();
+    }
+}
+
+
+// peak resident set size of the process in kilobytes
+static long peakRss()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+
+template <class HashType>
+static double insertSubCliques(HashType & hash, const std::vector<std::vector<clique> > & keyStream)
+{
+    size_t nextValue = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keyStream.size(); i++)
+        for (size_t j = 0; j < keyStream[i].size(); j++)
+            if (hash.getValue(keyStream[i][j]) < 0)
+                hash.put(keyStream[i][j], nextValue++);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+
+int main(int argc, char* argv[])
+{
+    size_t k = 4;
+    std::string table;
+    if (argc < 2)
+    {
+        std::cerr << HELPSTR << std::endl;
+        return EXIT_FAILURE;
+    }
+    for (int i = 2; i < argc; i++)
+    {
+        if (!strncmp(argv[i], "-k=", 3))
+            k = atoi(argv[i] + 3);
+        else if (!strcmp(argv[i], "-t=list") || !strcmp(argv[i], "-t=flat"))
+            table = argv[i] + 3;
+        else
+        {
+            std::cerr << "Invalid argument: " << argv[i] << std::endl << HELPSTR << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (k < 3)
+    {
+        std::cerr << "The value of k must be 3 or larger." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // phase I: build the stream of (k-1)-cliques, one group per new k-clique
+    std::ifstream file(argv[1]);
+    if (!file.is_open())
+    {
+        std::cerr << "Error opening the network file!\n";
+        return EXIT_FAILURE;
+    }
+    NetType net;
+    std::vector<std::vector<clique> > keyStream;
+    size_t numKeys = 0;
+    std::string line;
+    while (getline(file, line))
+    {
+        std::istringstream is(line);
+        size_t source, dest;
+        float weight;
+        if (!(is >> source >> dest >> weight))
+            continue;
+
+        std::vector<size_t> common;
+        for (NetType::const_edge_iterator i = net(source).begin(); !i.finished(); ++i)
+            if (net(*i)[dest] > 0)
+                common.push_back(*i);
+        std::vector<size_t> current(2);
+        current[0] = source;
+        current[1] = dest;
+        std::vector<std::vector<size_t> > newCliques;
+        extendCliques(net, current, common, k, newCliques);
+        net[source][dest] = weight;
+
+        for (size_t c = 0; c < newCliques.size(); c++)
+        {
+            std::vector<clique> subCliques;
+            for (size_t j = 0; j < k; j++)
+            {
+                std::vector<size_t> nodes;
+                for (size_t l = 0; l < k; l++)
+                    if (l != j)
+                        nodes.push_back(newCliques[c][l]);
+                subCliques.push_back(clique(nodes));
+            }
+            numKeys += subCliques.size();
+            keyStream.push_back(subCliques);
+        }
+    }
+    std::cout << "k-cliques: " << keyStream.size() << ", (k-1)-clique lookups: " << numKeys << std::endl;
+
+    // phase II: the same stream into both tables, or into the one given with -t. The chained table is sized for all
+    // the lookups, cliqueHash like weightedSCP does it, for one (k-1)-clique per k-clique, and grows on demand.
+    size_t hash_bits = determineHashSize(numKeys, k - 1);
+    if (!table.empty())
+    {
+        const long streamRss = peakRss();
+        double time;
+        size_t keys, slots;
+        if (table == "list")
+        {
+            listCliqueHash oldHash(static_cast<size_t>(1) << hash_bits, hash_bits, k - 1);
+            time = insertSubCliques(oldHash, keyStream);
+            keys = oldHash.getKeyCount();
+            slots = static_cast<size_t>(1) << hash_bits;
+        }
+        else
+        {
+            cliqueHash newHash(keyStream.size(), k - 1);
+            time = insertSubCliques(newHash, keyStream);
+            keys = newHash.getKeyCount();
+            slots = newHash.getSlotCount();
+        }
+        const long tableRss = peakRss();
+        std::cout << (table == "list" ? "listCliqueHash: " : "cliqueHash:     ") << time << "s, " << keys << " keys, " << slots << (table == "list" ? " buckets" : " slots") << std::endl;
+        std::cout << "peak RSS: " << streamRss << " kB with the stream, " << tableRss << " kB with the table (+"
+                  << tableRss - streamRss << " kB)" << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    listCliqueHash oldHash(static_cast<size_t>(1) << hash_bits, hash_bits, k - 1);
+    double oldTime = insertSubCliques(oldHash, keyStream);
+
+    cliqueHash newHash(keyStream.size(), k - 1);
+    double newTime = insertSubCliques(newHash, keyStream);
+
+    std::cout << "listCliqueHash: " << oldTime << "s, " << oldHash.getKeyCount() << " keys, " << (static_cast<size_t>(1) << hash_bits) << " buckets" << std::endl;
+    std::cout << "cliqueHash:     " << newTime << "s, " << newHash.getKeyCount() << " keys, " << newHash.getSlotCount() << " slots" << std::endl;
+
+    // both tables must hold the same keys with the same values
+    if (oldHash.getKeyCount() != newHash.getKeyCount())
+    {
+        std::cerr << "Key counts differ!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    for (std::pair<clique,size_t> currentPair = newHash.begin(); !newHash.finished(); currentPair = newHash.next())
+    {
+        if (oldHash.getValue(currentPair.first) != (int) currentPair.second)
+        {
+            std::cerr << "Tables differ at " << currentPair.first << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::cout << "Tables agree." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -20,194 +20,168 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include "cliqueHash.h"
 
 
-size_t cliqueHash::hash_function(const clique key)
-{
-    const size_t keySize = key.size();
-
+const size_t cliqueHash::emptySlot;
+const double cliqueHash::maxLoad = 0.7;
 
-    // std::cerr << "clique size for hash_function is " << key.size() << "\n";
-    size_t hash_key;
-    size_t newInd[keySize];
-    for (size_t i = 0; i < keySize; i++)
-        newInd[i] = key.at(keySize-1-i) & b;
 
+// mixes one node index into the running hash value
+static inline size_t combineHash(const size_t hash_key, const size_t node)
+{
+    return hash_key ^ (node + 0x9e3779b97f4a7c15ULL + (hash_key << 6) + (hash_key >> 2));
+}
 
-    //     for (size_t i = 1; i < keySize; i++) new_ind[i] = A*key.at(i);
-    hash_key = newInd[0] << hash_bits - offSet; // move to the left
-    size_t move;
-    for (size_t i = 1; i < keySize; i++)
-    {
-        move = hash_bits - (i+1)*offSet;
-        newInd[i] = newInd[i] << move;
-        hash_key = hash_key | newInd[i] ;      // take
-    }
 
+// final avalanche so that consecutive node indices spread over the whole table
+static inline size_t finalizeHash(size_t hash_key)
+{
+    hash_key ^= hash_key >> 33;
+    hash_key *= 0xff51afd7ed558ccdULL;
+    hash_key ^= hash_key >> 33;
+    return hash_key;
+}
 
-    hash_key = hash_key | ( key.at(keySize-2) & c );
 
-    // now take only the last hash_bits bits
+size_t cliqueHash::hash_function(const clique & key) const
+{
+    size_t hash_key = 0;
+    for (size_t i = 0; i < keySize; i++)
+        hash_key = combineHash(hash_key, key.at(i));
+    return finalizeHash(hash_key) & mask;
+}
 
-    //     hash_key = hash_key & a;
-    //     std::cerr << "hash key is: " << hash_key << "\n";
 
-    /*
-    hash_key = key.at(0)+1;
-    for (size_t i = 1; i < key.size(); i++) hash_key *= key.at(i);
-    hash_key = hash_key%size;
-    //     hash_key = (key.at(0)+1)*key.at(1)*key.at(2)*key.at(3)%size;
-    // hash_key = ( key.at(0) * key.at(3) + key.at(1) * key.at(2) )%size;
-    */
-    if (hash_key >= size || hash_key < 0 )
-    {
-        std::cerr << "hash function did not work!\n";
-        // std::cerr << "nodes were: " << key.at(0) << " " << key.at(1) << " " << key.at(2) << " " << key.at(3) << "\n";
-        std::cerr << "hash key was: " << hash_key << "\n";
-        std::cerr << "hash key size was: " << keySize << "\n";	
-    }
+size_t cliqueHash::hash_function(const size_t * key) const
+{
+    size_t hash_key = 0;
+    for (size_t i = 0; i < keySize; i++)
+        hash_key = combineHash(hash_key, key[i]);
+    return finalizeHash(hash_key) & mask;
+}
 
 
-    return hash_key;
+cliqueHash::cliqueHash(const size_t expectedKeys, const size_t keySize) : keySize(keySize), slotWidth(keySize + 1), keyCount(0), curr_slot(0)
+{
+    numSlots = 2;
+    while (numSlots * maxLoad < expectedKeys)
+        numSlots <<= 1;
+    mask = numSlots - 1;
+    arena.assign(numSlots * slotWidth, emptySlot);
 }
 
 
-cliqueHash::cliqueHash(const size_t hashSize, const size_t t, const size_t keySize)
+cliqueHash::cliqueHash() : cliqueHash(0, 1)
 {
-  hashTable.resize(hashSize); // reserve memory
-    keyCount = 0;
-    size = hashSize;
-    hash_bits = t;
-    offSet = hash_bits/keySize; // this is how much we can move bits for each index
-    a = 1;
-    a = a << hash_bits;
-    a = a - 1;    // beginning is zeros, only hash_bits lasts bits are one
-    b = 1;
-    b = b << offSet;
-    b = b-1;
-    c = 1;
-    c = c << ( hash_bits - keySize*offSet );
-    c = c - 1;
 }
 
 
-cliqueHash::cliqueHash()
+bool cliqueHash::keyEquals(const size_t slot, const clique & key) const
 {
-    cliqueHash(0, 1, 1);
+    const size_t * stored = &arena[slot * slotWidth + 1];
+    for (size_t i = 0; i < keySize; i++)
+        if (stored[i] != key.at(i))
+            return false;
+    return true;
 }
 
 
-bool cliqueHash::contains(const clique & key)
+size_t cliqueHash::findSlot(const clique & key) const
 {
-    // std::cerr << "entering contains-function\n";
-    size_t hash_key = hash_function(key);
-    //     std::cerr << "hash-key is:" << hash_key << "\n";
+    if (key.size() != keySize)
+        std::cerr << "clique of size " << key.size() << " used with a hash of key size " << keySize << "!\n";
 
-    bool key_found = false;
-    for (cliqueIndexSet::iterator i = hashTable.at(hash_key).begin(); !key_found && i != hashTable.at(hash_key).end(); i++)
+    size_t slot = hash_function(key);
+    while (arena[slot * slotWidth] != emptySlot && !keyEquals(slot, key))
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+
+void cliqueHash::rehash(const size_t newSlots)
+{
+    std::vector<size_t> oldArena;
+    oldArena.swap(arena);
+    arena.assign(newSlots * slotWidth, emptySlot);
+    const size_t oldSlots = numSlots;
+    numSlots = newSlots;
+    mask = numSlots - 1;
+
+    for (size_t i = 0; i < oldSlots; i++)
     {
-        if ( (*i).first == key ) key_found = true;
+        const size_t * oldSlot = &oldArena[i * slotWidth];
+        if (oldSlot[0] == emptySlot)
+            continue;
+        size_t slot = hash_function(oldSlot + 1);
+        while (arena[slot * slotWidth] != emptySlot)
+            slot = (slot + 1) & mask;
+        std::copy(oldSlot, oldSlot + slotWidth, arena.begin() + slot * slotWidth);
     }
-    //    std::cerr << "leaving contains-function\n";
-    return key_found;
 }
 
 
-int cliqueHash::getValue(const clique & key)
+bool cliqueHash::contains(const clique & key)
 {
-    size_t hash_key = hash_function(key);
+    return arena[findSlot(key) * slotWidth] != emptySlot;
+}
 
-    int value = -1;
-    bool key_found = false;
-    for (cliqueIndexSet::iterator i = hashTable.at(hash_key).begin(); !key_found && i != hashTable.at(hash_key).end(); i++)
-    {
-        if ( (*i).first == key )
-        {
-            value = (*i).second;
-            key_found = true;
-        }
-    }
+
+int cliqueHash::getValue(const clique & key)
+{
+    const size_t value = arena[findSlot(key) * slotWidth];
+    if (value == emptySlot)
+        return -1;
     return value;
 }
 
 
 void cliqueHash::put(const clique & key, const size_t value)
 {
-    size_t hash_key = hash_function(key);
-
-    if ( contains(key) )
+    size_t slot = findSlot(key);
+    if (arena[slot * slotWidth] == emptySlot)
     {
-        bool key_found = false;
-        for (cliqueIndexSet::iterator i = hashTable.at(hash_key).begin(); !key_found && i != hashTable.at(hash_key).end(); i++)
+        if ((keyCount + 1) > numSlots * maxLoad)
         {
-            if ( (*i).first == key )
-            {
-                (*i).second = value;
-                key_found = true;
-            }
+            rehash(numSlots << 1);
+            slot = findSlot(key);
         }
-    }
-    else
-    {
-        std::pair<clique,size_t> cliqueValPair(key,value);
-        hashTable.at(hash_key).push_back( cliqueValPair );
+        size_t * stored = &arena[slot * slotWidth];
+        for (size_t i = 0; i < keySize; i++)
+            stored[i + 1] = key.at(i);
         keyCount++;
     }
+    arena[slot * slotWidth] = value;
+}
+
+
+std::pair<clique,size_t> cliqueHash::slotPair(const size_t slot) const
+{
+    if (slot >= numSlots)
+        return std::make_pair(clique(), 0);
+    const size_t * stored = &arena[slot * slotWidth];
+    std::vector<size_t> nodes(stored + 1, stored + slotWidth);
+    return std::make_pair(clique(nodes), stored[0]);
 }
 
 
 std::pair<clique,size_t> cliqueHash::begin()
 {
-    curr_hash_key = 0;
-    while ( curr_hash_key < size && hashTable.at(curr_hash_key).size() == 0  )
-    {
-        curr_hash_key++;
-    }
-    if ( curr_hash_key < size )         // now we have found the first slot that is not empty
-    {
-        iter = hashTable.at(curr_hash_key).begin();
-        return *iter;
-    }
-    else
-    {
-        clique tmpClique;
-        currPair = std::make_pair( tmpClique, 0);
-        return currPair;
-    }
+    curr_slot = 0;
+    while (curr_slot < numSlots && arena[curr_slot * slotWidth] == emptySlot)
+        curr_slot++;
+    return slotPair(curr_slot);
 }
 
 std::pair<clique,size_t> cliqueHash::next()
 {
-    iter++;
-    if ( iter == hashTable.at(curr_hash_key).end() )    // move to the next non-empty slot
-    {
-        do
-        {
-            curr_hash_key++;
-        }
-        while ( curr_hash_key < size && hashTable.at(curr_hash_key).size() == 0  );
-        if ( curr_hash_key < size )         // now we have found the first slot that is not empty
-        {
-            iter = hashTable.at(curr_hash_key).begin();
-            return *iter;
-        }
-        else
-        {
-            clique tmpClique;
-            currPair = std::make_pair(tmpClique, 0);
-            return currPair;
-        }
-    }
-    else
+    do
     {
-        return *iter;
+        curr_slot++;
     }
+    while (curr_slot < numSlots && arena[curr_slot * slotWidth] == emptySlot);
+    return slotPair(curr_slot);
 }
 
 
 bool cliqueHash::finished()
 {
-
-    if ( curr_hash_key == size ) return true;
-    else if ( getKeyCount() == 0 ) return true;
-    else return false;
-
+    return curr_slot >= numSlots || keyCount == 0;
 }
@@ -20,33 +20,50 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef CLIQUE_HASH
 #define CLIQUE_HASH
 
-#include <list>
+#include <vector>
 #include "weighedClique.h"
 
+/*
+  Open addressing hash from (k-1)-cliques to their index in the KruskalTree.
 
+  All keys have the same width (given at construction), so every slot is stored
+  inline in a single arena as [value, node_0, ..., node_{keySize-1}]. Empty slots
+  have the value emptySlot. Collisions are resolved with linear probing and the
+  table doubles when the load factor exceeds maxLoad, so the size given to the
+  constructor is only a hint.
+*/
 class cliqueHash
 {
 
-    // typedef std::list<std::pair<clique,size_t> > cliqueIndexSet;
-    typedef std::list<std::pair<clique,size_t> > cliqueIndexSet;
-
 private:
 
-    size_t size;
-    std::vector<cliqueIndexSet> hashTable;
-    size_t hash_bits;
-    size_t a, b, c, offSet;
+    static const size_t emptySlot = static_cast<size_t>(-1);
+    static const double maxLoad;
 
-    size_t hash_function(const clique key);
+    size_t keySize;
+    size_t slotWidth;  // keySize + 1, the value is stored in front of the key
+    size_t numSlots;   // always a power of two
+    size_t mask;
+    std::vector<size_t> arena;
 
-    cliqueIndexSet::iterator iter;
-    std::pair<clique,size_t> currPair;
-    size_t curr_hash_key;
     size_t keyCount;
+    size_t curr_slot;
+
+    size_t hash_function(const clique & key) const;
+    size_t hash_function(const size_t * key) const;
+
+    // returns the slot holding key or the empty slot where it should be put
+    size_t findSlot(const clique & key) const;
+
+    bool keyEquals(const size_t slot, const clique & key) const;
+
+    void rehash(const size_t newSlots);
+
+    std::pair<clique,size_t> slotPair(const size_t slot) const;
 
 public:
 
-    cliqueHash(const size_t hashSize, const size_t t, const size_t keySize);
+    cliqueHash(const size_t expectedKeys, const size_t keySize);
 
 
     cliqueHash();
@@ -75,6 +92,12 @@ public:
         return keyCount;
     }
 
+
+    size_t getSlotCount() const
+    {
+        return numSlots;
+    }
+
 };
 
 #endif
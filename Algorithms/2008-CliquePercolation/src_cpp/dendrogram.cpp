@@ -63,7 +63,7 @@ void Dendrogram::printTree(std::ostream & file)
     for (std::vector<DendrogramNode*>::iterator i = nodes.begin(); i != nodes.end(); i++)
     {
         file << (*i)->weight << "\t" << (*i)->comIndex << "\t" << (*i)->size;
-        for (std::set<DendrogramNode*>::iterator j = (*i)->children.begin(); j != (*i)->children.end(); j++) // TESTI
+        for (std::vector<DendrogramNode*>::iterator j = (*i)->children.begin(); j != (*i)->children.end(); j++) // TESTI
             file << "\t|\t" << (*j)->comIndex << "\t" << (*j)->size; // TESTI
         file << std::endl;
     }
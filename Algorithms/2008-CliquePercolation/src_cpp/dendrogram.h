@@ -53,7 +53,7 @@ private:
         public:
             DendrogramNode(float weight, size_t size, size_t comIndex) : weight(weight), size(size), comIndex(comIndex), parent(NULL) {}
 
-            void addChild(DendrogramNode * child) { children.insert(child); } // TESTI
+            void addChild(DendrogramNode * child) { children.push_back(child); } // TESTI
 
         private:
             float weight;
@@ -61,7 +61,7 @@ private:
             size_t comIndex;
             DendrogramNode * parent;
 
-            std::set<DendrogramNode*> children; // TESTI
+            std::vector<DendrogramNode*> children; // TESTI, in insertion order so that printTree does not depend on pointer values
     };
 
     static bool compareNodes(DendrogramNode * first, DendrogramNode * second) { return first->weight > second->weight; }
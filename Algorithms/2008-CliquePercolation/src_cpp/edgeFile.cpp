@@ -0,0 +1,123 @@
+/*
+scp, The sequential clique percolation algorithm.
+Copyright (C) 2011  Aalto University
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "edgeFile.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+EdgeFile::EdgeFile(const char * fileName) : data(NULL), end(NULL), position(NULL), fileSize(0), lineNumber(0), opened(false), parseError(false)
+{
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0)
+    {
+        fileSize = fileStat.st_size;
+        if (fileSize == 0)
+            opened = true;
+        else
+        {
+            void * mapped = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                data = static_cast<const char *>(mapped);
+                end = data + fileSize;
+                madvise(mapped, fileSize, MADV_SEQUENTIAL);
+                opened = true;
+            }
+        }
+    }
+    close(fd);
+    rewind();
+}
+
+
+EdgeFile::~EdgeFile()
+{
+    if (data)
+        munmap(const_cast<char *>(data), fileSize);
+}
+
+
+static inline bool isBlank(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+
+// parses a non-negative integer, the map is not null terminated so strtoul can not be used
+static bool parseIndex(const char * & position, const char * end, size_t & value)
+{
+    while (position != end && isBlank(*position))
+        ++position;
+    if (position == end || *position < '0' || *position > '9')
+        return false;
+    value = 0;
+    for (; position != end && *position >= '0' && *position <= '9'; ++position)
+        value = value * 10 + (*position - '0');
+    return true;
+}
+
+
+static bool parseWeight(const char * & position, const char * end, float & value)
+{
+    while (position != end && isBlank(*position))
+        ++position;
+    char buffer[64];
+    size_t length = 0;
+    for (; position != end && !isBlank(*position) && *position != '\n' && length + 1 < sizeof(buffer); ++position)
+        buffer[length++] = *position;
+    buffer[length] = '\0';
+    char * parsedEnd;
+    value = strtof(buffer, &parsedEnd);
+    return length > 0 && parsedEnd == buffer + length;
+}
+
+
+bool EdgeFile::readLink(size_t & source, size_t & dest, float & weight)
+{
+    parseError = false;
+    while (position != end)
+    {
+        const char * lineEnd = static_cast<const char *>(memchr(position, '\n', end - position));
+        if (!lineEnd)
+            lineEnd = end;
+        const char * current = position;
+        position = lineEnd == end ? end : lineEnd + 1;
+
+        while (current != lineEnd && isBlank(*current))
+            ++current;
+        if (current == lineEnd) // empty line
+            continue;
+
+        ++lineNumber;
+        if (parseIndex(current, lineEnd, source) && parseIndex(current, lineEnd, dest) && parseWeight(current, lineEnd, weight))
+            return true;
+        parseError = true;
+        return false;
+    }
+    return false;
+}
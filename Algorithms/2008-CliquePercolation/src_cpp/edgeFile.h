@@ -0,0 +1,61 @@
+/*
+scp, The sequential clique percolation algorithm.
+Copyright (C) 2011  Aalto University
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef EDGE_FILE_H
+#define EDGE_FILE_H
+
+#include <cstddef>
+
+/*
+  Read-only memory map of an edge list file. The links are parsed straight from
+  the mapped text every time the file is streamed, so any number of passes can be
+  made over the links without keeping them in memory.
+*/
+class EdgeFile
+{
+public:
+    EdgeFile(const char * fileName);
+
+    ~EdgeFile();
+
+    bool isOpen() const { return opened; }
+
+    void rewind() { position = data; lineNumber = 0; }
+
+    // reads the next link, returns false at the end of the file or if the line could not be parsed
+    bool readLink(size_t & source, size_t & dest, float & weight);
+
+    bool failed() const { return parseError; } // true if the last readLink stopped at a malformed line
+
+    size_t getLineNumber() const { return lineNumber; }
+
+private:
+    EdgeFile(const EdgeFile &);
+    EdgeFile & operator=(const EdgeFile &);
+
+    const char * data;
+    const char * end;
+    const char * position;
+    size_t fileSize;
+    size_t lineNumber;
+    bool opened;
+    bool parseError;
+};
+
+#endif
@@ -42,207 +42,132 @@ at most one edge between two nodes in the edge file.\n\
 Options:\n\
 \t-o=[outputfile] : Write output to a specified file.\n\
 \t-k=[clique size] : The size of the clique.\n\
-\t-v : Verbose mode.\n "
+\t-v : Verbose mode.\n\
+\t-w : Use weighted clique percolation.\n\
+\t-b=[batch size] : In weighted mode, search the cliques of this many consecutive links in parallel.\n "
 
-//\t-w : Use weighted clique percolation.\n\
 //\t-f=[weightfunction] : Specifies a weight function when using weighted clique percolation.\n "
 
-struct Link{
-  size_t source;
-  size_t dest;
-  float weight;
-  Link(size_t source=0,size_t dest=0, float weight=0.0) : source(source), dest(dest), weight(weight) {}
-
-};
-
-
-// finds out the optimal size for the hash
-size_t determineHashSize(const size_t numElements, const size_t k)
-{
-    size_t size_limit = 26;
-    size_t t;
-    if ( k < size_limit)
-        t = k;
-    else
-        t = size_limit;
-    while ( t < 10 ) t += k;
-    while ( 1 << t < numElements && t <  size_limit )
-    {
-        t += k;
-    }
-    return t; // this many bits are needed
-}
-
 // determine the network size and number of links
 // same link must not be twice in the network!
-bool getNetSizeAndLinkNumbers(char * fileName, size_t & netSize, size_t & numLinks, std::list<Link> & linkList)
+bool getNetSizeAndLinkNumbers(EdgeFile & links, size_t & netSize, size_t & numLinks)
 {
-
-    std::ifstream myfile(fileName);
-    std::string line;
     size_t source, dest;
     float weight;
     netSize=0;
     numLinks=0;
 
-    if (myfile.is_open())
+    links.rewind();
+    while (links.readLink(source, dest, weight))
     {
-        while (!myfile.eof())
-        {
-            getline(myfile, line);   // Read a line from input into a string.
-            if (!line.empty())
-            {
-                std::istringstream is(line);  // Extract data using a stringstream.
-		if ((is >> source) && (is >> dest) && (is >> weight));
-		else {
-		  std::cerr<<"Error reading line "<<numLinks << std::endl;
-		  return false;}		
-
-		linkList.push_back(Link(source,dest,weight));
-
-                if (source > netSize)
-                    netSize = source; //the size of the net is determined by the largest node index
-                if (dest > netSize)
-                    netSize = dest;
-                ++numLinks;
-            }
-        }
-        myfile.close();
+        if (source > netSize)
+            netSize = source; //the size of the net is determined by the largest node index
+        if (dest > netSize)
+            netSize = dest;
+        ++numLinks;
+    }
+    if (links.failed())
+    {
+        std::cerr<<"Error reading line "<<links.getLineNumber() << std::endl;
+        return false;
     }
     ++netSize; // net size is one more than the largest index
-    //std::cout << "ok\n";
     return true;
 }
 
-/*
-  reads one line from the input file. The line contains the source and target nodes and weight.
-*/
-bool readLine(std::ifstream & myfile, size_t & source,  size_t & dest, float & weight)
+// adds nodes from candidates[depth] to 'current' until it is a k-clique, every candidate list is a subset of the previous one
+static void extendClique(std::vector<weighedClique> & cliqueVector, const NetType & net, const SortedAdjacency & adjacency, std::vector<size_t> & current, std::vector<std::vector<SortedAdjacency::NodeIndex> > & candidates, const size_t k, const size_t weightFunction)
 {
-    bool readlineok = false;
-    if ( myfile.is_open())
+    const size_t depth = current.size();
+    const std::vector<SortedAdjacency::NodeIndex> & nodes = candidates[depth];
+    for (size_t i = 0; i + (k - depth) <= nodes.size(); i++)
     {
-
-        std::string line;
-        getline(myfile, line);   // Read a line from input into a string.
-        if (!line.empty())
+        current.push_back(nodes[i]);
+        if (depth + 1 == k)
         {
-            std::istringstream is(line);  // Extract data using a stringstream.
-            is >> source;
-            is >> dest;
-            is >> weight;
-            readlineok = true;
+            weighedClique tempClique(current, net, weightFunction);
+            cliqueVector.push_back(tempClique);
         }
+        else
+        {
+            // only nodes after i, so that every clique is found once
+            candidates[depth + 1].clear();
+            adjacency.commonNeighbours(nodes.data() + i + 1, nodes.data() + nodes.size(), nodes[i], candidates[depth + 1]);
+            extendClique(cliqueVector, net, adjacency, current, candidates, k, weightFunction);
+        }
+        current.pop_back();
     }
-    else
-    {
-        std::cerr << "Error opening the network file!\n";
-    }
-    return readlineok;
 }
 
-void kCliquesFind(std::vector<weighedClique> & cliqueVector, NetType & net, size_t source, size_t dest, const float weight, const size_t k, const size_t weightFunction)
+// finds the k-cliques containing the link source-dest, the link itself must already be in net for the clique weights
+static void kCliquesSearch(std::vector<weighedClique> & cliqueVector, const NetType & net, const SortedAdjacency & adjacency, const size_t source, const size_t dest, const size_t k, const size_t weightFunction)
 {
+  std::vector<size_t> tempVector(2);
+  tempVector[0] = source;
+  tempVector[1] = dest;
 
   // If k=2 cliques are links and the only new clique formed is the added link itself.
   if (k==2){
-    std::vector<size_t> tempVector(2);
-    tempVector[0] = source; tempVector[1] = dest;
     weighedClique tempClique(tempVector, net, weightFunction);
     cliqueVector.push_back(tempClique);
-    net[source][dest] = weight; // add link
-    return;
   }
-  
-  // find out degrees of source and dest
-  size_t k_s, k_d;
-  k_s = net(source).size(); 
-  k_d = net(dest).size();
-  
-  // If degree of 'source' is larger than degree of 'dest', swap these. This makes it faster because we only iterate through nodes which are neighbors of 'source'.
-  if (k_s > k_d)
+  else if ( adjacency.degree(source) > k - 3 && adjacency.degree(dest) > k - 3 )   // if this is not true, a new k-clique can not form
     {
-      size_t temp = source;
-      source = dest;
-      dest = temp;
+      // The new k-cliques are the (k-2)-cliques in the common neighbourhood of source and dest.
+      // candidates[d] holds the nodes adjacent to all d nodes chosen so far.
+      std::vector<std::vector<SortedAdjacency::NodeIndex> > candidates(k);
+      adjacency.commonNeighbours(source, dest, candidates[2]);
+      extendClique(cliqueVector, net, adjacency, tempVector, candidates, k, weightFunction);
     }
-  
+}
+
+void kCliquesFind(std::vector<weighedClique> & cliqueVector, NetType & net, SortedAdjacency & adjacency, size_t source, size_t dest, const float weight, const size_t k, const size_t weightFunction)
+{
+  // the weights of the new cliques include the new link
+  net[source][dest] = weight;
+  kCliquesSearch(cliqueVector, net, adjacency, source, dest, k, weightFunction);
+  adjacency.addLink(source, dest);
+}
 
-  if ( k_s  > k - 3 && k_d > k - 3)   // if this is not true, a new k-clique can not form
+/*
+  Finds the new k-cliques for a batch of consecutive links using all threads. All links of the batch are
+  added first, and a clique found for the i-th link is kept only if none of its other links comes later in
+  the batch. This way each clique is reported for the same link and in the same order as by calling
+  kCliquesFind for the links one at a time.
+*/
+void kCliquesFindBatch(std::vector<weighedClique> & cliqueVector, NetType & net, SortedAdjacency & adjacency, const std::vector<Link> & batch, const size_t k, const size_t weightFunction)
+{
+    std::map<std::pair<size_t,size_t>, size_t> batchPosition;
+    for (size_t i = 0; i < batch.size(); i++)
     {
-      if (k == 3)
-        {
-	  std::vector<size_t> tempVector(3);
-            tempVector[0] = source;
-            tempVector[1] = dest;
-            for ( NetType::const_edge_iterator i=net(source).begin(); !i.finished(); ++i)
-	      {
-                if ( net(*i)[dest] > 0 )
-		  {
-                    tempVector[2] = *i;
-                    weighedClique tempClique(tempVector, net, weightFunction);
-                    cliqueVector.push_back(tempClique);		    
-		  }
-	      }	    
-        }
-      else if (k == 4)
+        net[batch[i].source][batch[i].dest] = batch[i].weight;
+        adjacency.addLink(batch[i].source, batch[i].dest);
+        batchPosition[std::make_pair(std::min(batch[i].source, batch[i].dest), std::max(batch[i].source, batch[i].dest))] = i;
+    }
+
+    const NetType & constNet = net;
+    std::vector<std::vector<weighedClique> > batchCliques(batch.size());
+#pragma omp parallel for schedule(dynamic)
+    for (long i = 0; i < (long) batch.size(); i++)
+    {
+        std::vector<weighedClique> found;
+        kCliquesSearch(found, constNet, adjacency, batch[i].source, batch[i].dest, k, weightFunction);
+        for (std::vector<weighedClique>::iterator c = found.begin(); c != found.end(); ++c)
         {
-	  std::vector<size_t> tempVector(4);
-	  tempVector[0] = source;
-	  tempVector[1] = dest;
-	  for ( NetType::const_edge_iterator i=net(source).begin(); !i.finished(); ++i)
-            {
-	      NetType::const_edge_iterator j=i;
-	      for ( ++j; !j.finished(); ++j) // makes j to point to the next iterable after i
+            bool laterLink = false;
+            for (size_t l = 0; !laterLink && l < k; l++)
+                for (size_t m = l + 1; !laterLink && m < k; m++)
                 {
-		  if ( net(*i)[dest] > 0 && net(*j)[dest] > 0 && net(*i)[*j] > 0)
-                    {
-		      tempVector[2] = *i;
-		      tempVector[3] = *j;
-		      weighedClique tempClique(tempVector, net, weightFunction);
-		      cliqueVector.push_back(tempClique);
-                    }
+                    std::map<std::pair<size_t,size_t>, size_t>::const_iterator position = batchPosition.find(std::make_pair(c->at(l), c->at(m)));
+                    laterLink = position != batchPosition.end() && position->second > (size_t) i;
                 }
-            }	  
-        }
-      else // k>4
-        {
-	  nodeSet commonNeighborhood;
-	  for ( NetType::const_edge_iterator i=net(source).begin(); !i.finished(); ++i)
-            {
-	      if ( net(*i)[dest] > 0 )
-		commonNeighborhood.put(*i);
-            }
-	  
-	  NetType subNet(commonNeighborhood.size());
-	  
-	  std::vector<size_t> sourceAndDest(2);
-	  sourceAndDest[0] = source;
-	  sourceAndDest[1] = dest;
-	  
-	  std::vector<weighedClique> k2cliqueVector;
-	  for (nodeSet::iterator i = commonNeighborhood.begin(); !i.finished(); ++i)
-            {
-	      nodeSet::iterator j = i;
-	      for ( ++j; !j.finished(); ++j) // makes j to point to the next iterable after i
-                {
-		  if (net(*i)[*j] > 0)
-                    {
-		      kCliquesFind(k2cliqueVector, subNet, *i, *j, net(*i)[*j], k - 2, 0);
-		      for (std::vector<weighedClique>::iterator vectorIter = k2cliqueVector.begin(); vectorIter != k2cliqueVector.end(); vectorIter++)
-                        {
-			  weighedClique current = *vectorIter;
-			  current.addNodes(sourceAndDest, net);
-			  cliqueVector.push_back(current);
-                        }
-                    }
-                }
-            }	  
+            if (!laterLink)
+                batchCliques[i].push_back(*c);
         }
     }
 
-  //Finally add the new link to the network
-  net[source][dest] = weight; 
+    for (size_t i = 0; i < batchCliques.size(); i++)
+        cliqueVector.insert(cliqueVector.end(), batchCliques[i].begin(), batchCliques[i].end());
 }
 
 void kCommunitiesFind(std::vector<weighedClique> & cliqueVector, KruskalTree & communities, cliqueHash & k1cliquesHash, NetType & net, const size_t k)
@@ -320,7 +245,7 @@ void outputCommunityStructure(KruskalTree & communities, cliqueHash & k1cliquesH
 }
 
 
-void unweightedSCP(NetType & net, std::list<Link> & linkList, const size_t numberOfLinks, const size_t k, std::string outputFile,bool verbose)
+void unweightedSCP(NetType & net, EdgeFile & links, const size_t numberOfLinks, const size_t k, std::string outputFile,bool verbose)
 {
     size_t source, dest;
     float weight;
@@ -330,36 +255,32 @@ void unweightedSCP(NetType & net, std::list<Link> & linkList, const size_t numbe
     size_t numberOfSmallCliques=0;
     NetType *tempNetPointer= new NetType(net.size());
     NetType &tempNet=*tempNetPointer;
-    for (std::list<Link>::iterator linkIterator=linkList.begin() ; linkIterator != linkList.end(); linkIterator++ )
+    SortedAdjacency *tempAdjacencyPointer= new SortedAdjacency(net.size());
+    links.rewind();
+    while (links.readLink(source, dest, weight))
     {
-      source=(*linkIterator).source; dest=(*linkIterator).dest;weight=(*linkIterator).weight;
       cliqueVector.clear();
-      kCliquesFind(cliqueVector, tempNet, source, dest, weight, k-1, 0);
+      kCliquesFind(cliqueVector, tempNet, *tempAdjacencyPointer, source, dest, weight, k-1, 0);
       numberOfSmallCliques+=cliqueVector.size();
     }
     delete tempNetPointer;
+    delete tempAdjacencyPointer;
 
     //Use the number of k-1 cliques to determine the hash size
-    size_t hash_bits = determineHashSize(numberOfSmallCliques, k - 1);
-    size_t numSlots=1; numSlots = numSlots << hash_bits; // Number of slots is 2**hash_bits
+    cliqueHash k1cliquesHash(numberOfSmallCliques, k - 1);
     if (verbose){
       std::cout<< "Number of "<< k-1 <<"-cliques: " <<numberOfSmallCliques<<std::endl;
-      std::cout<<"Number of bits in the hash table: "<<hash_bits<<std::endl;
-      std::cout<<"Number of slots in the hash table: "<<numSlots<<std::endl;
+      std::cout<<"Number of slots in the hash table: "<<k1cliquesHash.getSlotCount()<<std::endl;
     }
-    cliqueHash k1cliquesHash(numSlots, hash_bits, k - 1);        
 
     KruskalTree communities;
-    size_t nLinksLeft=linkList.size();
-    while (nLinksLeft>0)
+    SortedAdjacency adjacency(net.size());
+    links.rewind();
+    while (links.readLink(source, dest, weight))
     {
-      nLinksLeft--;
-      Link link=linkList.front();linkList.pop_front();
-      source=link.source;dest=link.dest;weight=link.weight;
-    
       // phase I
       cliqueVector.clear();
-      kCliquesFind(cliqueVector, net, source, dest, weight, k, 0);
+      kCliquesFind(cliqueVector, net, adjacency, source, dest, weight, k, 0);
       
       // phase II
       kCommunitiesFind(cliqueVector, communities, k1cliquesHash, net, k);
@@ -400,7 +321,7 @@ void kCommunitiesFindWeighted(std::vector<weighedClique> & cliqueVector, Kruskal
     //dendrogram.printTree(dendrogramOutputFile);
 }
 
-void weightedSCP(NetType & net, std::ifstream & file, const size_t numberOfLinks, const size_t k, const float threshold, const size_t weightFunction, std::string outputFile)
+void weightedSCP(NetType & net, EdgeFile & links, const size_t numberOfLinks, const size_t k, const float threshold, const size_t weightFunction, std::string outputFile, const size_t batchSize)
 {
     size_t source, dest;
     float weight;
@@ -409,17 +330,33 @@ void weightedSCP(NetType & net, std::ifstream & file, const size_t numberOfLinks
     std::vector<weighedClique> cliqueVector;
 
     // phase I
-    while (readLine(file, source, dest, weight))
-        kCliquesFind(cliqueVector, net, source, dest, weight, k, weightFunction);
+    SortedAdjacency adjacency(net.size());
+    links.rewind();
+    if (batchSize > 1)
+    {
+        std::vector<Link> batch;
+        bool linksLeft = true;
+        while (linksLeft)
+        {
+            batch.clear();
+            while (batch.size() < batchSize && (linksLeft = links.readLink(source, dest, weight)))
+                batch.push_back(Link(source, dest, weight));
+            kCliquesFindBatch(cliqueVector, net, adjacency, batch, k, weightFunction);
+        }
+    }
+    else
+        while (links.readLink(source, dest, weight))
+            kCliquesFind(cliqueVector, net, adjacency, source, dest, weight, k, weightFunction);
 
     std::sort(cliqueVector.begin(), cliqueVector.end(), weighedCliqueCmp);
 
     //std::cout << cliqueVector.size() << " k-cliques" << std::endl;
 
-    // Use an upper bound for the number of k-1 cliques as hash size. Each k-clique has k k-1 cliques.
-    size_t hash_bits = determineHashSize(cliqueVector.size() * k, k - 1);
-
-    cliqueHash k1cliquesHash(1 << hash_bits, hash_bits, k - 1);
+    // Only the k-cliques above the threshold are added, and neighbouring ones share most of their k-1 cliques,
+    // so the k bound for each is far too large. Size the hash for one k-1 clique per added k-clique, it grows on demand.
+    const size_t percolatedCliques = std::partition_point(cliqueVector.begin(), cliqueVector.end(),
+        [threshold](const weighedClique & c) { return c.getWeight() >= threshold; }) - cliqueVector.begin();
+    cliqueHash k1cliquesHash(percolatedCliques, k - 1);
     KruskalTree communities;
 
     // phase II
@@ -431,15 +368,18 @@ void weightedSCP(NetType & net, std::ifstream & file, const size_t numberOfLinks
     //std::cout << "largest: " << communities.getLargestComponentSize() << std::endl;
 }
 
-bool validateLinkList(std::list<Link> &linkList,size_t netSize,bool verbose){
+bool validateLinks(EdgeFile &links,size_t netSize,bool verbose){
   if (verbose) std::cout << "Checking that the node labels are not sparce and there are no multiedges... ";
   NetType tempNet;
-  for (std::list<Link>::iterator linkIterator=linkList.begin() ; linkIterator != linkList.end(); linkIterator++ ){
-    if (tempNet[linkIterator->source][linkIterator->dest]!=0){
+  size_t source, dest;
+  float weight;
+  links.rewind();
+  while (links.readLink(source, dest, weight)){
+    if (tempNet[source][dest]!=0){
       std::cerr <<"Error: The input file contains multi-edges."<<std::endl;
       return false;
     }
-    tempNet[linkIterator->source][linkIterator->dest]=linkIterator->weight;
+    tempNet[source][dest]=weight;
   }
   if (tempNet.size()!=netSize){
     std::cerr <<"Error: Node labels are sparse. Please name nodes from 0 to n-1."<<std::endl;
@@ -450,31 +390,36 @@ bool validateLinkList(std::list<Link> &linkList,size_t netSize,bool verbose){
 }
 
 
-int percolation(char * fileName, const size_t k, const size_t weighted, const float threshold, const size_t weightFunction, std::string outputFile,bool verbose,bool sanityCheck)
+int percolation(char * fileName, const size_t k, const size_t weighted, const float threshold, const size_t weightFunction, std::string outputFile,bool verbose,bool sanityCheck, const size_t batchSize)
 {
     size_t numberOfLinks;
     size_t netSize;
-    std::list<Link> linkList;
-    
-    // First read in the network from the file
+
+    // The links are streamed from the memory mapped file, first to find out the network size
+    EdgeFile links(fileName);
+    if (!links.isOpen())
+    {
+        std::cerr << "Error opening the network file!\n";
+        return EXIT_FAILURE;
+    }
     if (verbose) std::cout << "Reading in the network...\n";
-    if (!getNetSizeAndLinkNumbers(fileName, netSize, numberOfLinks,linkList)) return EXIT_FAILURE;    
+    if (!getNetSizeAndLinkNumbers(links, netSize, numberOfLinks)) return EXIT_FAILURE;
     if (verbose) std::cout<< "Number of nodes: " << netSize << "\nNumber of links: " <<numberOfLinks << "\n";
+    if (netSize > SortedAdjacency::maxSize)
+    {
+        std::cerr << "Node indices must be smaller than " << SortedAdjacency::maxSize << ".\n";
+        return EXIT_FAILURE;
+    }
 
     //Check that the edge list is valid, this will waste some time
-    if (sanityCheck) if (!validateLinkList(linkList,netSize,verbose)) return EXIT_FAILURE;
+    if (sanityCheck) if (!validateLinks(links,netSize,verbose)) return EXIT_FAILURE;
 
     // Finally, proceed with the clique percolation
-    std::ifstream file(fileName);
-    if (file.is_open())
-    {
-        NetType net(netSize);
-        if (!weighted)
-	  unweightedSCP(net, linkList, numberOfLinks, k, outputFile,verbose);
-        if (weighted)
-            weightedSCP(net, file, numberOfLinks, k, threshold, weightFunction, outputFile);
-    }
-    file.close();
+    NetType net(netSize);
+    if (!weighted)
+      unweightedSCP(net, links, numberOfLinks, k, outputFile,verbose);
+    if (weighted)
+      weightedSCP(net, links, numberOfLinks, k, threshold, weightFunction, outputFile, batchSize);
     return EXIT_SUCCESS;
 }
 
@@ -485,6 +430,7 @@ int main(int argc, char* argv[])
     size_t weighted = 0;
     float threshold = 0;
     size_t weightFunction = 0;
+    size_t batchSize = 1;
     bool verbose=false;
     std::string outputFile;
 
@@ -497,9 +443,11 @@ int main(int argc, char* argv[])
 	outputFile = argv[i] + 3;
       else if (!strcmp(argv[i], "-v"))
 	verbose=true;
-/*
       else if (!strcmp(argv[i], "-w"))
 	weighted = 1;
+      else if (!strncmp(argv[i], "-b=", 3))
+	batchSize = atoi(argv[i] + 3);
+/*
       else if (!strncmp(argv[i], "-t=", 3))
 	threshold = atof(argv[i] + 3);
       else if (!strcmp(argv[i], "-f"))
@@ -535,7 +483,7 @@ int main(int argc, char* argv[])
 
 
     //--- Run clique percolation    
-    int exitCode=percolation(argv[1], k, weighted, threshold, weightFunction, outputFile,verbose,true);
+    int exitCode=percolation(argv[1], k, weighted, threshold, weightFunction, outputFile,verbose,true,batchSize);
 
 
     // calculate timings
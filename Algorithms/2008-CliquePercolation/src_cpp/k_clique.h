@@ -31,10 +31,13 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #include <set>
 #include <ctime>
 #include <list>
+#include <algorithm>
 
 #include "weighedClique.h"
 //#include "numSet2.h"
 #include "cliqueHash.h"
+#include "sortedAdjacency.h"
+#include "edgeFile.h"
 //#include "multiIter.h"
 #include "kruskal.h"
 #include "nodeCommunities.h"
@@ -52,26 +55,35 @@ typedef Set<size_t> nodeSet; // needs laboratory's library
 //typedef std::vector<numSet2> vectorSet; // standard library
 //typedef std::map< clique, size_t > nodeCliqueMap;
 
-size_t determineHashSize(const size_t numElements, const size_t k);
+struct Link{
+  size_t source;
+  size_t dest;
+  float weight;
+  Link(size_t source=0,size_t dest=0, float weight=0.0) : source(source), dest(dest), weight(weight) {}
 
-void getNetSizeAndLinkNumbers(char * fileName, size_t & netSize, size_t & numLinks);
+};
 
-bool readLine(std::ifstream & myfile, size_t & source, size_t & dest, float & weight);
 
-void kCliquesFind(std::vector<weighedClique> & cliqueVector, NetType & net, size_t source, size_t dest, const float weight, const size_t k, const size_t weightFunction);
+bool getNetSizeAndLinkNumbers(EdgeFile & links, size_t & netSize, size_t & numLinks);
+
+void kCliquesFind(std::vector<weighedClique> & cliqueVector, NetType & net, SortedAdjacency & adjacency, size_t source, size_t dest, const float weight, const size_t k, const size_t weightFunction);
+
+void kCliquesFindBatch(std::vector<weighedClique> & cliqueVector, NetType & net, SortedAdjacency & adjacency, const std::vector<Link> & batch, const size_t k, const size_t weightFunction);
 
 void kCommunitiesFind(std::vector<weighedClique> & cliqueVector, KruskalTree & communities, cliqueHash & k1cliquesHash, NetType & net, const size_t k);
 
 void outputCommunityStructure(KruskalTree & communities, cliqueHash & k1cliquesHash, std::ofstream & file);
 
-void unweightedSCP(NetType & net, std::ifstream & file, const size_t numberOfLinks, const size_t k);
+void unweightedSCP(NetType & net, EdgeFile & links, const size_t numberOfLinks, const size_t k, std::string outputFile, bool verbose);
 
 bool weighedCliqueCmp(weighedClique lhs, weighedClique rhs);
 
 void kCommunitiesFindWeighted(std::vector<weighedClique> & cliqueVector, KruskalTree & communities, cliqueHash & k1cliquesHash, NetType & net, const size_t k, const float threshold);
 
-void weightedSCP(NetType & net, std::ifstream & file, const size_t numberOfLinks, const size_t k, const float threshold, const size_t weightFunction);
+void weightedSCP(NetType & net, EdgeFile & links, const size_t numberOfLinks, const size_t k, const float threshold, const size_t weightFunction, std::string outputFile, const size_t batchSize);
+
+bool validateLinks(EdgeFile & links, size_t netSize, bool verbose);
 
-void percolation(char * fileName, const size_t k, const size_t weighted, const float threshold, const size_t weightFunction);
+int percolation(char * fileName, const size_t k, const size_t weighted, const float threshold, const size_t weightFunction, std::string outputFile, bool verbose, bool sanityCheck, const size_t batchSize);
 
 #endif
@@ -17,27 +17,36 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
 */
 
+
 #include "kruskal.h"
 
+#include <algorithm>
 #include <iostream>
+#include <cstring>
+
+const size_t KruskalTree::rootFlag;
+
+static const char checkpointMagic[8] = {'S', 'C', 'P', 'K', 'T', 'R', 'E', '1'};
 
 KruskalTree::KruskalTree() : largestComponentSize(1) {}
 
 size_t KruskalTree::add()
 {
     size_t vecSize = table.size();
-    table.push_back(vecSize);
-    commSizes.push_back(1);
+    Entry entry = { vecSize | rootFlag, 1 };
+    table.push_back(entry);
     return vecSize;
 }
 
 size_t KruskalTree::add(const size_t root)
 {
-    if (root <= table.size())
+    if (root < table.size())
     {
-        table.push_back(root);
-        findRoot(table[table.size() - 1]);
-        commSizes.push_back(1);
+        size_t internalRoot = findInternalRoot(root);
+        Entry entry = { internalRoot, 0 };
+        table.push_back(entry);
+        if (++table[internalRoot].size > largestComponentSize)
+            largestComponentSize = table[internalRoot].size;
     }
     else
         add();
@@ -46,43 +55,54 @@ size_t KruskalTree::add(const size_t root)
 
 void KruskalTree::connect(const size_t first, const size_t second)
 {
-    if (first < table.size() && second < table.size() && !inSameSet(first, second)) // After the call inSameSet table[first] and table[second] point to their real roots
+    if (first < table.size() && second < table.size())
     {
-        commSizes[table[second]] += commSizes[table[first]];
-        if (commSizes[table[second]] > largestComponentSize)
-            largestComponentSize = commSizes[table[second]];
-        table[table[first]] = table[table[second]];
+        size_t firstRoot = findInternalRoot(first);
+        size_t secondRoot = findInternalRoot(second);
+        if (firstRoot == secondRoot)
+            return;
+
+        const size_t label = table[secondRoot].parent; // the label of second, with the root flag
+        const size_t newSize = table[firstRoot].size + table[secondRoot].size;
+        if (table[firstRoot].size > table[secondRoot].size)
+            std::swap(firstRoot, secondRoot);
+        table[firstRoot].parent = secondRoot; // the smaller set under the larger one
+        table[secondRoot].parent = label;
+        table[secondRoot].size = newSize;
+        if (newSize > largestComponentSize)
+            largestComponentSize = newSize;
     }
 }
 
 bool KruskalTree::inSameSet(const size_t first, const size_t second)
 {
-    if (findRoot(first) == findRoot(second))
-        return true;
-    else
-        return false;
+    return findInternalRoot(first) == findInternalRoot(second);
 }
 
-size_t KruskalTree::findRoot(const size_t source)
+size_t KruskalTree::findInternalRoot(const size_t source)
 {
-    size_t root = table[source];
-    while (root != table[root])
-    {
-        root = table[root];
-    }
-    size_t currentRoot = source;
-    while (currentRoot != root)
+    size_t root = source;
+    while (!(table[root].parent & rootFlag))
+        root = table[root].parent;
+
+    size_t current = source;
+    while (current != root)
     {
-        size_t oldRoot = table[currentRoot];
-        table[currentRoot] = root;
-        currentRoot = oldRoot;
+        size_t next = table[current].parent;
+        table[current].parent = root;
+        current = next;
     }
     return root;
 }
 
+size_t KruskalTree::findRoot(const size_t source)
+{
+    return table[findInternalRoot(source)].parent & ~rootFlag;
+}
+
 size_t KruskalTree::size(const size_t source)
 {
-    return commSizes[findRoot(source)];
+    return table[findInternalRoot(source)].size;
 }
 
 size_t KruskalTree::getLargestComponentSize() const
@@ -92,7 +112,115 @@ size_t KruskalTree::getLargestComponentSize() const
 
 void KruskalTree::printTree(std::ostream & file) const
 {
-    for (int i = 0; i < table.size(); i++)
-        file << i << ": " << table[i] << " s: " << commSizes[i] << std::endl;
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        if (table[i].parent & rootFlag)
+            file << i << ": root, label " << (table[i].parent & ~rootFlag) << " s: " << table[i].size << std::endl;
+        else
+            file << i << ": " << table[i].parent << std::endl;
+    }
     file << std::endl;
 }
+
+void KruskalTree::save(std::ostream & file) const
+{
+    const size_t count = table.size();
+    file.write(checkpointMagic, sizeof(checkpointMagic));
+    file.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char *>(&largestComponentSize), sizeof(largestComponentSize));
+    if (count)
+        file.write(reinterpret_cast<const char *>(&table[0]), count * sizeof(Entry));
+}
+
+bool KruskalTree::load(std::istream & file)
+{
+    char magic[sizeof(checkpointMagic)];
+    size_t count, largest;
+    if (!file.read(magic, sizeof(magic)) || memcmp(magic, checkpointMagic, sizeof(magic)) != 0)
+    {
+        std::cerr << "Not a KruskalTree checkpoint!\n";
+        return false;
+    }
+    if (!file.read(reinterpret_cast<char *>(&count), sizeof(count)) || !file.read(reinterpret_cast<char *>(&largest), sizeof(largest)))
+    {
+        std::cerr << "Truncated KruskalTree checkpoint!\n";
+        return false;
+    }
+
+    // the count comes from the file, so it is bounded by what the stream holds before anything is allocated
+    const std::streampos start = file.tellg();
+    if (start != std::streampos(-1) && file.seekg(0, std::ios::end))
+    {
+        const std::streamoff available = file.tellg() - start;
+        file.seekg(start);
+        if (count > static_cast<size_t>(available) / sizeof(Entry))
+        {
+            std::cerr << "Truncated KruskalTree checkpoint!\n";
+            return false;
+        }
+    }
+    else
+        file.clear();
+
+    // a stream which can't seek is read in blocks, so a bad count only costs what is really there
+    std::vector<Entry> newTable;
+    const size_t block = 1 << 16;
+    while (newTable.size() < count)
+    {
+        const size_t done = newTable.size();
+        newTable.resize(done + std::min(block, count - done));
+        if (!file.read(reinterpret_cast<char *>(&newTable[done]), (newTable.size() - done) * sizeof(Entry)))
+        {
+            std::cerr << "Truncated KruskalTree checkpoint!\n";
+            return false;
+        }
+    }
+    if (!consistent(newTable, largest))
+    {
+        std::cerr << "Inconsistent KruskalTree checkpoint!\n";
+        return false;
+    }
+    table.swap(newTable);
+    largestComponentSize = largest;
+    return true;
+}
+
+bool KruskalTree::consistent(const std::vector<Entry> & entries, const size_t largest)
+{
+    const size_t count = entries.size();
+    // root of each element, count while it is being looked for, count + 1 before
+    std::vector<size_t> rootOf(count, count + 1);
+    std::vector<size_t> members(count, 0);
+    std::vector<size_t> path;
+    size_t largestSize = 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t current = i;
+        while (rootOf[current] == count + 1 && !(entries[current].parent & rootFlag))
+        {
+            rootOf[current] = count;
+            path.push_back(current);
+            current = entries[current].parent;
+            if (current >= count || rootOf[current] == count)
+                return false; // outside the table, or a cycle
+        }
+        const size_t root = rootOf[current] < count ? rootOf[current] : current;
+        if (root == current)
+        {
+            // a root: its label is one of the elements and its size one of the possible ones
+            if ((entries[root].parent & ~rootFlag) >= count || entries[root].size == 0 || entries[root].size > count)
+                return false;
+            rootOf[root] = root;
+            largestSize = std::max(largestSize, entries[root].size);
+        }
+        for (size_t p = 0; p < path.size(); p++)
+            rootOf[path[p]] = root;
+        path.clear();
+    }
+    for (size_t i = 0; i < count; i++)
+        members[rootOf[i]]++;
+    for (size_t i = 0; i < count; i++)
+        if ((entries[i].parent & rootFlag) && members[i] != entries[i].size)
+            return false;
+    return largest == largestSize;
+}
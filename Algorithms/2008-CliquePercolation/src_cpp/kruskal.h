@@ -25,34 +25,65 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "weighedClique.h"
 
+/*
+  Union-find over the (k-1)-clique indices with union by size and full path compression.
+
+  The sets are linked by size internally, but every set also has a label which is what
+  findRoot returns: after connect(first, second) the set has the label of second.
+  CommunityTracker and nodeCommunities rely on this to keep their community indices
+  in sync with the tree.
+
+  Each element is one Entry. For a root, parent holds the label with rootFlag set and
+  size is the size of the set; for other elements parent is the parent index.
+*/
 class KruskalTree
 {
 public:
     KruskalTree();
 
-    size_t add(); // return the index where the element was added ( = table.size() - 1 )
+    size_t add(); // return the index where the element was added ( = number of elements - 1 )
 
-    size_t add(const size_t root); // same as above
+    size_t add(const size_t root); // adds an element to the set of root, returns its index
 
-    void connect(const size_t first, const size_t second); // connects two sets, after the operation the first points to the root of second
+    void connect(const size_t first, const size_t second); // connects two sets, after the operation the set is labelled as the root of second
 
     bool inSameSet(const size_t first, const size_t second); // checks if two elements belong to same set
 
-    size_t findRoot(const size_t source); // finds the real root of an element
+    size_t findRoot(const size_t source); // finds the label of the set of an element
 
     size_t size(const size_t source);
 
     size_t getLargestComponentSize() const;
 
+    size_t getElementCount() const { return table.size(); }
+
     void printTree(std::ostream & file) const;
 
+    // binary checkpoint of the whole structure, load replaces the current contents and returns false,
+    // leaving the tree unchanged, on a truncated or inconsistent checkpoint
+    void save(std::ostream & file) const;
+
+    bool load(std::istream & file);
+
 private:
 
-    std::vector<size_t> table; // stores the pointer to root
-    std::vector<size_t> commSizes; // sizes of the sets are kept here
+    struct Entry
+    {
+        size_t parent;
+        size_t size;
+    };
+
+    static const size_t rootFlag = ~(~static_cast<size_t>(0) >> 1);
+
+    std::vector<Entry> table;
 
     size_t largestComponentSize;
 
+    size_t findInternalRoot(const size_t source); // the element which is the root of the set
+
+    // every parent is an element, every element reaches a root and the sizes agree with the sets
+    static bool consistent(const std::vector<Entry> & entries, const size_t largest);
+
 };
 
 #endif
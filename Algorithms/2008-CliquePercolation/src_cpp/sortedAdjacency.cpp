@@ -0,0 +1,200 @@
+/*
+scp, The sequential clique percolation algorithm.
+Copyright (C) 2011  Aalto University
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#include "sortedAdjacency.h"
+
+#include <algorithm>
+
+// the AVX2 loop is compiled for that target alone and chosen at run time, so the default build uses it
+// on the processors that have it
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SORTED_ADJACENCY_AVX2
+#include <immintrin.h>
+#endif
+
+// if one array is this many times longer, the shorter one is searched in the longer one instead of merging
+static const size_t gallopRatio = 32;
+
+// the recently added neighbours are merged once there are more of them than this and
+// than the square root of the merged ones
+static const size_t minRecent = 16;
+
+
+SortedAdjacency::SortedAdjacency(const size_t netSize) : adjacency(netSize) {}
+
+
+void SortedAdjacency::insertNeighbour(const size_t node, const size_t neighbour)
+{
+    if (node >= adjacency.size())
+        adjacency.resize(node + 1);
+    std::vector<NodeIndex> & merged = adjacency[node].merged;
+    std::vector<NodeIndex> & recent = adjacency[node].recent;
+    recent.insert(std::lower_bound(recent.begin(), recent.end(), (NodeIndex) neighbour), (NodeIndex) neighbour);
+    if (recent.size() <= minRecent || recent.size() * recent.size() <= merged.size())
+        return;
+
+    // merge from the back, so that the merged array is only moved once
+    size_t i = merged.size(), j = recent.size(), k = i + j;
+    merged.resize(k);
+    while (j > 0)
+    {
+        if (i > 0 && merged[i - 1] > recent[j - 1])
+            merged[--k] = merged[--i];
+        else
+            merged[--k] = recent[--j];
+    }
+    recent.clear();
+}
+
+
+void SortedAdjacency::addLink(const size_t source, const size_t dest)
+{
+    insertNeighbour(source, dest);
+    insertNeighbour(dest, source);
+}
+
+
+bool SortedAdjacency::isLink(const size_t source, const size_t dest) const
+{
+    if (degree(source) > degree(dest))
+        return isLink(dest, source);
+    if (source >= adjacency.size())
+        return false;
+    const Neighbours & neighbours = adjacency[source];
+    return std::binary_search(neighbours.recent.begin(), neighbours.recent.end(), (NodeIndex) dest)
+        || std::binary_search(neighbours.merged.begin(), neighbours.merged.end(), (NodeIndex) dest);
+}
+
+
+// appends the intersection of the two arrays to out and merges it with the sorted elements of out from start on
+static void intersectAndMerge(const SortedAdjacency::NodeIndex * first1, const SortedAdjacency::NodeIndex * last1, const std::vector<SortedAdjacency::NodeIndex> & second, std::vector<SortedAdjacency::NodeIndex> & out, const size_t start)
+{
+    const size_t middle = out.size();
+    SortedAdjacency::intersect(first1, last1, second.data(), second.data() + second.size(), out);
+    if (middle > start && out.size() > middle)
+        std::inplace_merge(out.begin() + start, out.begin() + middle, out.end());
+}
+
+
+void SortedAdjacency::commonNeighbours(const size_t source, const size_t dest, std::vector<NodeIndex> & out) const
+{
+    if (source >= adjacency.size() || dest >= adjacency.size())
+        return;
+    const Neighbours & first = adjacency[source];
+    const Neighbours & second = adjacency[dest];
+    const size_t start = out.size();
+    intersectAndMerge(first.merged.data(), first.merged.data() + first.merged.size(), second.merged, out, start);
+    intersectAndMerge(first.merged.data(), first.merged.data() + first.merged.size(), second.recent, out, start);
+    intersectAndMerge(first.recent.data(), first.recent.data() + first.recent.size(), second.merged, out, start);
+    intersectAndMerge(first.recent.data(), first.recent.data() + first.recent.size(), second.recent, out, start);
+}
+
+
+void SortedAdjacency::commonNeighbours(const NodeIndex * first, const NodeIndex * last, const size_t node, std::vector<NodeIndex> & out) const
+{
+    if (node >= adjacency.size())
+        return;
+    const size_t start = out.size();
+    intersectAndMerge(first, last, adjacency[node].merged, out, start);
+    intersectAndMerge(first, last, adjacency[node].recent, out, start);
+}
+
+
+static void gallopIntersect(const SortedAdjacency::NodeIndex * first1, const SortedAdjacency::NodeIndex * last1, const SortedAdjacency::NodeIndex * first2, const SortedAdjacency::NodeIndex * last2, std::vector<SortedAdjacency::NodeIndex> & out)
+{
+    for (; first1 != last1 && first2 != last2; ++first1)
+    {
+        first2 = std::lower_bound(first2, last2, *first1);
+        if (first2 != last2 && *first2 == *first1)
+            out.push_back(*first1);
+    }
+}
+
+
+#ifdef SORTED_ADJACENCY_AVX2
+static bool cpuHasAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+static const bool useAvx2 = cpuHasAvx2();
+
+
+// intersects blocks of eight while both arrays have that many left, advancing first1 and first2 past them
+__attribute__((target("avx2")))
+static void avx2IntersectBlocks(const SortedAdjacency::NodeIndex * & first1, const SortedAdjacency::NodeIndex * last1, const SortedAdjacency::NodeIndex * & first2, const SortedAdjacency::NodeIndex * last2, std::vector<SortedAdjacency::NodeIndex> & out)
+{
+    // compare blocks of eight against each other: every element of the first block is
+    // compared against all rotations of the second block
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while (last1 - first1 >= 8 && last2 - first2 >= 8)
+    {
+        const __m256i block1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first1));
+        __m256i block2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first2));
+        __m256i match = _mm256_cmpeq_epi32(block1, block2);
+        for (int rotation = 1; rotation < 8; rotation++)
+        {
+            block2 = _mm256_permutevar8x32_epi32(block2, rotate);
+            match = _mm256_or_si256(match, _mm256_cmpeq_epi32(block1, block2));
+        }
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(match));
+        for (int i = 0; i < 8; i++)
+            if (mask & (1 << i))
+                out.push_back(first1[i]);
+
+        const SortedAdjacency::NodeIndex max1 = first1[7], max2 = first2[7];
+        if (max1 <= max2)
+            first1 += 8;
+        if (max2 <= max1)
+            first2 += 8;
+    }
+}
+#endif
+
+
+void SortedAdjacency::intersect(const NodeIndex * first1, const NodeIndex * last1, const NodeIndex * first2, const NodeIndex * last2, std::vector<NodeIndex> & out)
+{
+    const size_t size1 = last1 - first1, size2 = last2 - first2;
+    if (size1 == 0 || size2 == 0)
+        return;
+    if (size1 * gallopRatio < size2)
+        return gallopIntersect(first1, last1, first2, last2, out);
+    if (size2 * gallopRatio < size1)
+        return gallopIntersect(first2, last2, first1, last1, out);
+
+#ifdef SORTED_ADJACENCY_AVX2
+    if (useAvx2)
+        avx2IntersectBlocks(first1, last1, first2, last2, out);
+#endif
+
+    while (first1 != last1 && first2 != last2)
+    {
+        if (*first1 < *first2)
+            ++first1;
+        else if (*first2 < *first1)
+            ++first2;
+        else
+        {
+            out.push_back(*first1);
+            ++first1;
+            ++first2;
+        }
+    }
+}
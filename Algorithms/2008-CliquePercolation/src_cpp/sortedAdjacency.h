@@ -0,0 +1,77 @@
+/*
+scp, The sequential clique percolation algorithm.
+Copyright (C) 2011  Aalto University
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+#ifndef SORTED_ADJACENCY_H
+#define SORTED_ADJACENCY_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+/*
+  Unweighted adjacency kept as sorted neighbour arrays of 32 bit node indices, so that
+  common neighbourhoods can be computed by merging arrays instead of looking every node
+  up in the hash of the other. The weights stay in NetType.
+
+  The neighbours of a node are split into a long merged array and a short array of the
+  recently added ones. A new neighbour is inserted into the short array, which is merged
+  into the long one once its length exceeds the square root of the long one. Adding the
+  d links of a hub then costs O(d sqrt(d)) instead of O(d^2), and the queries intersect
+  both arrays.
+*/
+class SortedAdjacency
+{
+public:
+    typedef uint32_t NodeIndex;
+
+    // node indices must be smaller than this
+    static const size_t maxSize = UINT32_MAX;
+
+    SortedAdjacency(const size_t netSize = 0);
+
+    void addLink(const size_t source, const size_t dest); // the link must not be in the network yet
+
+    bool isLink(const size_t source, const size_t dest) const;
+
+    size_t degree(const size_t node) const { return node < adjacency.size() ? adjacency[node].merged.size() + adjacency[node].recent.size() : 0; }
+
+    size_t size() const { return adjacency.size(); }
+
+    // writes the sorted common neighbours of source and dest to the end of out
+    void commonNeighbours(const size_t source, const size_t dest, std::vector<NodeIndex> & out) const;
+
+    // writes the sorted neighbours of node that are in the sorted array [first, last) to the end of out
+    void commonNeighbours(const NodeIndex * first, const NodeIndex * last, const size_t node, std::vector<NodeIndex> & out) const;
+
+    // writes the sorted intersection of the sorted arrays [first1, last1) and [first2, last2) to the end of out
+    static void intersect(const NodeIndex * first1, const NodeIndex * last1, const NodeIndex * first2, const NodeIndex * last2, std::vector<NodeIndex> & out);
+
+private:
+    struct Neighbours
+    {
+        std::vector<NodeIndex> merged;
+        std::vector<NodeIndex> recent;
+    };
+
+    std::vector<Neighbours> adjacency;
+
+    void insertNeighbour(const size_t node, const size_t neighbour);
+};
+
+#endif
@@ -0,0 +1,224 @@
+/*
+scp, The sequential clique percolation algorithm.
+Copyright (C) 2011  Aalto University
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+*/
+
+/*
+Round trip of the KruskalTree checkpoint.
+
+A tree is built with random connections and saved. The loaded copy must answer
+findRoot, size and getLargestComponentSize like the original, and must keep doing
+so while the same connections are applied to both. A checkpoint with a bad magic,
+cut anywhere before its end, with a count larger than the file, or with a table
+which doesn't describe a forest of the given sizes, must be refused and leave the
+tree unchanged.
+
+Returns 0 if all the checks pass.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../kruskal.h"
+
+static int failures = 0;
+
+static void check(const bool condition, const std::string & what)
+{
+    if (!condition)
+    {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// same sets, labels and sizes in both trees
+static bool sameTree(KruskalTree & a, KruskalTree & b)
+{
+    if (a.getElementCount() != b.getElementCount() || a.getLargestComponentSize() != b.getLargestComponentSize())
+        return false;
+    for (size_t i = 0; i < a.getElementCount(); i++)
+        if (a.findRoot(i) != b.findRoot(i) || a.size(i) != b.size(i))
+            return false;
+    return true;
+}
+
+static void connectRandomly(KruskalTree & a, KruskalTree & b, const size_t connections)
+{
+    for (size_t c = 0; c < connections; c++)
+    {
+        const size_t first = rand() % a.getElementCount(), second = rand() % a.getElementCount();
+        if (!a.inSameSet(first, second))
+            a.connect(first, second);
+        if (!b.inSameSet(first, second))
+            b.connect(first, second);
+    }
+}
+
+static std::string checkpoint(const KruskalTree & tree)
+{
+    std::ostringstream out(std::ios::binary);
+    tree.save(out);
+    return out.str();
+}
+
+// the checkpoint with the size_t at byte offset replaced
+static std::string patched(const std::string & saved, const size_t offset, const size_t value)
+{
+    std::string result = saved;
+    memcpy(&result[offset], &value, sizeof(value));
+    return result;
+}
+
+// serves a string, but like a pipe it can't seek
+class UnseekableBuffer : public std::streambuf
+{
+public:
+    explicit UnseekableBuffer(const std::string & data) : data(data)
+    {
+        char * begin = &this->data[0];
+        setg(begin, begin, begin + this->data.size());
+    }
+private:
+    std::string data;
+};
+
+static void checkRefused(KruskalTree & tree, const std::string & bad, const std::string & what)
+{
+    const std::string before = checkpoint(tree);
+    std::istringstream in(bad, std::ios::binary);
+    bool loaded = true;
+    try
+    {
+        loaded = tree.load(in);
+    }
+    catch (...)
+    {
+        check(false, what + " throws");
+        return;
+    }
+    check(!loaded, what + " is refused");
+    check(checkpoint(tree) == before, what + " leaves the tree unchanged");
+}
+
+int main()
+{
+    srand(1);
+
+    // empty tree
+    {
+        KruskalTree empty, loaded;
+        std::istringstream in(checkpoint(empty), std::ios::binary);
+        check(loaded.load(in) && sameTree(empty, loaded), "round trip of an empty tree");
+    }
+
+    // elements added alone and into existing sets, then some sets joined
+    KruskalTree tree;
+    for (size_t i = 0; i < 2000; i++)
+    {
+        if (i % 3 == 2)
+            tree.add(tree.findRoot(rand() % i));
+        else
+            tree.add();
+    }
+    for (size_t c = 0; c < 400; c++)
+    {
+        const size_t first = rand() % tree.getElementCount(), second = rand() % tree.getElementCount();
+        if (!tree.inSameSet(first, second))
+            tree.connect(first, second);
+    }
+    const std::string saved = checkpoint(tree);
+
+    // round trip, then the same connections on both copies
+    KruskalTree loaded;
+    {
+        std::istringstream in(saved, std::ios::binary);
+        check(loaded.load(in), "load of a complete checkpoint");
+    }
+    check(sameTree(tree, loaded), "loaded tree equals the saved one");
+    connectRandomly(tree, loaded, 600);
+    check(sameTree(tree, loaded), "loaded tree keeps equal under further connections");
+    check(checkpoint(tree) == checkpoint(loaded), "checkpoints of both copies are identical");
+
+    // a refused load leaves the tree as it was
+    const std::string before = checkpoint(loaded);
+
+    std::string badMagic = saved;
+    badMagic[0] = 'X';
+    {
+        std::istringstream in(badMagic, std::ios::binary);
+        check(!loaded.load(in), "bad magic is refused");
+        check(checkpoint(loaded) == before, "bad magic leaves the tree unchanged");
+    }
+
+    // cut inside the magic, the header and the table
+    const size_t cuts[] = { 0, 4, 8, 12, 8 + sizeof(size_t), 8 + 2 * sizeof(size_t) + 1, saved.size() / 2, saved.size() - 1 };
+    for (size_t c = 0; c < sizeof(cuts) / sizeof(cuts[0]); c++)
+    {
+        std::istringstream in(saved.substr(0, cuts[c]), std::ios::binary);
+        std::ostringstream what;
+        what << "checkpoint truncated to " << cuts[c] << " of " << saved.size() << " bytes";
+        check(!loaded.load(in), what.str() + " is refused");
+        check(checkpoint(loaded) == before, what.str() + " leaves the tree unchanged");
+    }
+
+    // corrupt header and table; the table starts after the magic, the count and the largest size,
+    // and each entry is a parent followed by a size
+    const size_t countAt = 8, largestAt = 8 + sizeof(size_t), tableAt = 8 + 2 * sizeof(size_t);
+    const size_t entry = 2 * sizeof(size_t), rootFlag = ~(~static_cast<size_t>(0) >> 1);
+    size_t root = 0, child = 0, parent, rootSize;
+    for (memcpy(&parent, &saved[tableAt], sizeof(parent)); !(parent & rootFlag); memcpy(&parent, &saved[tableAt + root * entry], sizeof(parent)))
+        root++;
+    for (memcpy(&parent, &saved[tableAt], sizeof(parent)); parent & rootFlag; memcpy(&parent, &saved[tableAt + child * entry], sizeof(parent)))
+        child++;
+    memcpy(&rootSize, &saved[tableAt + root * entry + sizeof(size_t)], sizeof(rootSize));
+    const size_t elements = tree.getElementCount();
+
+    checkRefused(loaded, patched(saved, countAt, ~static_cast<size_t>(0) >> 4), "a huge count");
+    checkRefused(loaded, patched(saved, countAt, ~static_cast<size_t>(0)), "the largest count");
+    checkRefused(loaded, patched(saved, countAt, elements + 1), "a count one too large");
+    checkRefused(loaded, patched(saved, largestAt, tree.getLargestComponentSize() + 1), "a wrong largest size");
+    checkRefused(loaded, patched(saved, tableAt + child * entry, elements), "a parent outside the table");
+    checkRefused(loaded, patched(saved, tableAt + child * entry, child), "an element its own parent");
+    checkRefused(loaded, patched(saved, tableAt + root * entry, child), "a root turned into a child");
+    checkRefused(loaded, patched(saved, tableAt + root * entry, rootFlag | elements), "a label outside the table");
+    checkRefused(loaded, patched(saved, tableAt + root * entry + sizeof(size_t), rootSize + 1), "a wrong set size");
+
+    // a stream which can't tell its size: the table is read as far as it goes
+    {
+        const std::string huge = patched(saved, countAt, ~static_cast<size_t>(0) >> 4);
+        UnseekableBuffer hugeBuffer(huge), completeBuffer(saved);
+        std::istream hugeIn(&hugeBuffer), completeIn(&completeBuffer);
+        const std::string before = checkpoint(loaded);
+        check(!loaded.load(hugeIn) && checkpoint(loaded) == before, "a huge count in an unseekable stream is refused");
+        KruskalTree fromUnseekable, fromString;
+        std::istringstream in(saved, std::ios::binary);
+        check(fromUnseekable.load(completeIn) && fromString.load(in) && sameTree(fromUnseekable, fromString),
+              "load from an unseekable stream");
+    }
+
+    if (failures)
+    {
+        std::cerr << failures << " checks failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "KruskalTree checkpoint round trip OK" << std::endl;
+    return EXIT_SUCCESS;
+}
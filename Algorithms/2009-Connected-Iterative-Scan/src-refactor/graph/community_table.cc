@@ -0,0 +1,47 @@
+#include "community_table.h"
+
+/**
+ *@fn uint64_t community_table::Fingerprint ( const vector < int >& community )
+ *
+ * Hash of the members in order (splitmix64 mixing of a running value).
+ */
+uint64_t community_table::Fingerprint ( const vector < int >& community ){
+  uint64_t h = community.size();
+  for (unsigned int i = 0; i < community.size(); i++){
+    h += 0x9e3779b97f4a7c15ULL + (uint32_t) community[i];
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+  }
+  return h;
+}
+
+bool community_table::Insert ( const vector < int >& community ){
+  uint64_t key = Fingerprint(community);
+  shard& s = shards[key % SHARDS];
+
+  lock_guard < mutex > guard ( s.lock );
+  auto range = s.communities.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it){
+    if ( it->second == community ) return false;
+  }
+  s.communities.insert(pair < uint64_t, vector < int > > (key, community));
+  return true;
+}
+
+int community_table::Size () const {
+  int size = 0;
+  for (unsigned int i = 0; i < shards.size(); i++) size += shards[i].communities.size();
+  return size;
+}
+
+vector < vector < int > > community_table::Communities () const {
+  vector < vector < int > > result;
+  result.reserve(Size());
+  for (unsigned int i = 0; i < shards.size(); i++){
+    for (auto it = shards[i].communities.begin(); it != shards[i].communities.end(); ++it){
+      result.push_back(it->second);
+    }
+  }
+  return result;
+}
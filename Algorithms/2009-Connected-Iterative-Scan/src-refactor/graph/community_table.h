@@ -0,0 +1,44 @@
+#ifndef RPI_COMMUNITY_TABLE
+#define RPI_COMMUNITY_TABLE
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ *@class community_table
+ *
+ * Set of distinct communities that many threads can insert into at once. A community is a sorted vector of
+ * vertex ids, hashed into a 64-bit fingerprint. The fingerprint picks one of the shards, each with its own lock,
+ * and communities with the same fingerprint are compared member by member, so collisions cost time but never
+ * lose a community.
+ */
+class community_table {
+public:
+    community_table() : shards(SHARDS) {};
+
+    ~community_table() {};
+
+    bool Insert(const vector<int> &community); //False if the community was already in the table
+
+    int Size() const;
+
+    vector<vector<int> > Communities() const; //In no particular order
+
+    static uint64_t Fingerprint(const vector<int> &community);
+
+private:
+    static const int SHARDS = 64;
+
+    struct shard {
+        mutex lock;
+        unordered_multimap<uint64_t, vector<int> > communities;
+    };
+
+    vector<shard> shards;
+};
+
+#endif
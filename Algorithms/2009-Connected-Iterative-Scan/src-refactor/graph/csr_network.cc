@@ -0,0 +1,109 @@
+#include "csr_network.h"
+
+#include <algorithm>
+
+#include "../util/io_helper.h"
+
+struct csr_arc {
+  int fr, to;
+  double weight;
+
+  bool operator< ( const csr_arc& other ) const {
+    return fr != other.fr ? fr < other.fr : to < other.to;
+  }
+};
+
+/**
+ *@fn void csr_network::Load ( const string& filename, const string& delimiters, const bool& directed )
+ *
+ * Loads the network from an edge list, the same format temporal_network::AddNetwork reads: one edge per
+ * line, node1|node2|edge_weight. Lines without exactly three fields are skipped, lines with a bad weight
+ * only add their vertices. If an edge is given more than once the last weight is kept.
+ *
+ *@param filename Name of the file to load the network from
+ *@param delimiters Characters to be used as the delimiter for the network file
+ *@param directed Indicator as to whether or not the edges are directed
+ */
+void csr_network::Load ( const string& filename, const string& delimiters, const bool& directed ){
+  ifstream fin;                                              //Open file
+  openFileHarsh(&fin, filename);
+
+  vector < string > fields;
+  vector < csr_arc > arcs;
+  names.clear();
+  ids.clear();
+
+  while ( fline_tr( &fin, &fields, delimiters ) ){
+    if (fields.size() != 3) continue;                        //Simple format check
+
+    int ends[2];
+    for (int i = 0; i < 2; i++){                             //Intern the names, numbered by first appearance for now
+      pair < unordered_map < string, int >::iterator, bool > ret = ids.insert(pair < string, int > (fields[i], names.size()));
+      if ( ret.second ) names.push_back(fields[i]);
+      ends[i] = ret.first->second;
+    }
+
+    pair < double, bool > ret = check_str_to<double>(fields[2]);  //Get edge weight
+    if ( !ret.second ) continue;                          //Wrong format
+
+    csr_arc arc = { ends[0], ends[1], ret.first };
+    arcs.push_back(arc);
+    if ( !directed ){
+      csr_arc back = { ends[1], ends[0], ret.first };
+      arcs.push_back(back);
+    }
+  }
+
+  fin.close();
+
+  //Renumber the vertices in the order of their names
+  vector < int > order ( names.size() ), rank ( names.size() );
+  for (unsigned int i = 0; i < order.size(); i++) order[i] = i;
+  sort(order.begin(), order.end(), [this]( const int& a, const int& b ){ return names[a] < names[b]; });
+  vector < string > sorted_names ( names.size() );
+  for (unsigned int i = 0; i < order.size(); i++){
+    rank[order[i]] = i;
+    sorted_names[i].swap(names[order[i]]);
+  }
+  names.swap(sorted_names);
+  for (unsigned int i = 0; i < names.size(); i++) ids[names[i]] = i;
+
+  for (unsigned int i = 0; i < arcs.size(); i++){
+    arcs[i].fr = rank[arcs[i].fr];
+    arcs[i].to = rank[arcs[i].to];
+  }
+  stable_sort(arcs.begin(), arcs.end());                      //Repeated edges stay in file order
+
+  offsets.assign(names.size() + 1, 0);
+  targets.clear();
+  weights.clear();
+  for (unsigned int i = 0; i < arcs.size(); i++){
+    if ( i + 1 < arcs.size() && arcs[i + 1].fr == arcs[i].fr && arcs[i + 1].to == arcs[i].to ) continue; //Keep the last weight
+    targets.push_back(arcs[i].to);
+    weights.push_back(arcs[i].weight);
+    offsets[arcs[i].fr + 1]++;
+  }
+  for (unsigned int v = 0; v < names.size(); v++) offsets[v + 1] += offsets[v];
+}
+
+int csr_network::Id ( const string& name ) const {
+  unordered_map < string, int >::const_iterator it = ids.find(name);
+  if ( it == ids.end() ) return -1;
+  return it->second;
+}
+
+/**
+ *@fn int csr_network::AddVertex ( const string& name )
+ *
+ * Vertices added after loading don't keep the order of the names.
+ */
+int csr_network::AddVertex ( const string& name ){
+  int v = Id(name);
+  if ( v >= 0 ) return v;
+
+  v = names.size();
+  names.push_back(name);
+  ids.insert(pair < string, int > (name, v));
+  offsets.push_back(offsets.back());
+  return v;
+}
@@ -0,0 +1,54 @@
+#ifndef RPI_CSR_NETWORK
+#define RPI_CSR_NETWORK
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ *@class csr_network
+ *
+ * Read-only network with integer vertex ids, stored as weighted neighbor arrays (compressed sparse rows).
+ * The names are interned once while loading and the vertices are numbered in the order of their names,
+ * so ordering vertices by id gives the same order as comparing their names, like cmp_str_ptr does.
+ * The neighbors of each vertex are sorted by id.
+ */
+class csr_network {
+public:
+    csr_network() {};
+
+    ~csr_network() {};
+
+    void Load(const string &filename, const string &delimiters, const bool &directed);
+
+    int VertexCount() const { return names.size(); }
+
+    int Degree(const int &v) const { return offsets[v + 1] - offsets[v]; }
+
+    //Edges of v are EdgesBegin(v) .. EdgesEnd(v) - 1
+    int EdgesBegin(const int &v) const { return offsets[v]; }
+
+    int EdgesEnd(const int &v) const { return offsets[v + 1]; }
+
+    int Target(const int &e) const { return targets[e]; }
+
+    double Weight(const int &e) const { return weights[e]; }
+
+    const string &Name(const int &v) const { return names[v]; }
+
+    int Id(const string &name) const; //-1 if the vertex is not in the network
+
+    int AddVertex(const string &name); //Adds a vertex without edges, or returns the id it already has
+
+private:
+    vector<string> names;
+    unordered_map<string, int> ids;
+
+    vector<int> offsets; //VertexCount() + 1 entries
+    vector<int> targets;
+    vector<double> weights;
+};
+
+#endif
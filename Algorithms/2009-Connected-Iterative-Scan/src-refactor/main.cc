@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <limits>
 
+#include "graph/community_table.h"
+#include "graph/csr_network.h"
 #include "graph/temporal_network.h"
 #include "util/parameters_helper.h"
 
@@ -45,7 +48,7 @@ double CalcDensity(const int &size, const double &Win, const double &Wout, const
 }
 
 /**
- *map < double, set < shared_ptr < string >, cmp_str_ptr > > Components ( set < shared_ptr < string >, cmp_str_ptr > seed, shared_ptr < Network > G, double lambda )
+ *map < double, set < int > > Components ( const set < int >& seed, const csr_network& G, double lambda )
  *
  *  Splits a set of vertices into the connected components that it is made up of. Associates each component
  * with its density value.
@@ -56,12 +59,12 @@ double CalcDensity(const int &size, const double &Win, const double &Wout, const
  *
  *@return A map associating density values with the components
  */
-map<double, set<shared_ptr<string>, cmp_str_ptr> >
-Components(set<shared_ptr<string>, cmp_str_ptr> seed, shared_ptr<network> G, double lambda) {
-    map<double, set<shared_ptr<string>, cmp_str_ptr> > result;
+map<double, set<int> >
+Components(const set<int> &seed, const csr_network &G, double lambda) {
+    map<double, set<int> > result;
 
-    set<shared_ptr<string>, cmp_str_ptr>::iterator it_s, it_u, it_v;
-    set<shared_ptr<string>, cmp_str_ptr> seen;
+    set<int>::const_iterator it_s, it_u;
+    set<int> seen;
     double win = 0, wout = 0;
 
     for (it_s = seed.begin(); it_s != seed.end(); it_s++) {                   //Go through each vertex in set
@@ -69,7 +72,7 @@ Components(set<shared_ptr<string>, cmp_str_ptr> seed, shared_ptr<network> G, dou
 
         win = 0;
         wout = 0;
-        set<shared_ptr<string>, cmp_str_ptr> component, to_check;
+        set<int> component, to_check;
         to_check.insert(*it_s);                                                  //Initialize stats for new component
 
         //Keep expanding the component based off the neighborhoods of members until no new members can be added
@@ -78,25 +81,23 @@ Components(set<shared_ptr<string>, cmp_str_ptr> seed, shared_ptr<network> G, dou
             it_u = to_check.begin();
             component.insert(*it_u);
             seen.insert(*it_u);
-            map<shared_ptr<string>, double, cmp_str_ptr> N = G->GetNeighborhood(*it_u);
+            int u = *it_u;
             to_check.erase(it_u);
 
             //Go through vertex neighborhodd to find vertices that are also in the component while tracking density measures
-            map<shared_ptr<string>, double, cmp_str_ptr>::iterator it_n;
-            for (it_n = N.begin(); it_n != N.end(); it_n++) {
-                if ((seen.find(it_n->first) == seen.end()) && (seed.find(it_n->first) != seed.end())) {
-                    to_check.insert(it_n->first);
-                    win += it_n->second;
+            for (int e = G.EdgesBegin(u); e < G.EdgesEnd(u); e++) {
+                if ((seen.find(G.Target(e)) == seen.end()) && (seed.find(G.Target(e)) != seed.end())) {
+                    to_check.insert(G.Target(e));
+                    win += G.Weight(e);
                 } else {
-                    wout += it_n->second;
+                    wout += G.Weight(e);
                 }
             }
         }
 
         //document results
         result.insert(
-                pair<double, set<shared_ptr<string>, cmp_str_ptr> >(CalcDensity(component.size(), win, wout, lambda),
-                                                                    component));
+                pair<double, set<int> >(CalcDensity(component.size(), win, wout, lambda), component));
     }
 
     //Return full results
@@ -104,206 +105,202 @@ Components(set<shared_ptr<string>, cmp_str_ptr> seed, shared_ptr<network> G, dou
 }
 
 /**
- *void ExpandSeed ( set < shared_ptr < string >, cmp_str_ptr >& seed, shared_ptr < Network > G, double lambda )
+ *struct expansion_state
+ *
+ * Win and Wout of the members and neighbors of the seed being expanded, kept in arrays over all the vertices
+ * so that looking a vertex up is just an index. Only the vertices in touched are ever set, and Clear() puts
+ * them back, so an expansion costs in proportion to the vertices it reaches, not to the size of the network.
+ * Each thread keeps its own.
+ */
+struct expansion_state {
+    enum { NONE = 0, MEMBER = 1, NEIGHBOR = 2 };
+
+    vector<double> win, wout;
+    vector<char> where;
+    vector<int> touched;
+
+    void Prepare(const int &vertices) {
+        if ((int) where.size() < vertices) {
+            win.resize(vertices, 0);
+            wout.resize(vertices, 0);
+            where.resize(vertices, NONE);
+        }
+    }
+
+    void Set(const int &v, const char &place, const double &in, const double &out) {
+        if (where[v] == NONE) touched.push_back(v);
+        where[v] = place;
+        win[v] = in;
+        wout[v] = out;
+    }
+
+    //The vertices in place, by degree and then by id (the order they are checked in)
+    void Collect(const char &place, const csr_network &G, vector<int> &result) const {
+        result.clear();
+        for (unsigned int i = 0; i < touched.size(); i++) {
+            if (where[touched[i]] == place) result.push_back(touched[i]);
+        }
+        sort(result.begin(), result.end(), [&G](const int &a, const int &b) {
+            return G.Degree(a) != G.Degree(b) ? G.Degree(a) < G.Degree(b) : a < b;
+        });
+    }
+
+    void Clear() {
+        for (unsigned int i = 0; i < touched.size(); i++) {
+            where[touched[i]] = NONE;
+            win[touched[i]] = 0;
+            wout[touched[i]] = 0;
+        }
+        touched.clear();
+    }
+};
+
+/**
+ *void ExpandSeed ( set < int >& seed, const csr_network& G, double lambda )
  *
  * Main portion of CIS. Takes a seed and iteratively adds neighbors/removes members in order to maximize the
  *  CalcDensity() value of the set of vertices. Only rule is that the component must remain connected. If it
  *  becomes disconnected, the component that has the highest independant density is taken.
+ * Only reads the network, so several seeds can be expanded at once.
+ *
+ * The Win and Wout of every member and neighbor are kept up to date as vertices move: moving a vertex only
+ *  touches its own edges. A vertex that becomes a neighbor has its edges summed once, in edge order: taking
+ *  its Wout from its strength rounds differently with fractional weights and changes the CalcDensity comparisons.
  *
  *@param seed Set of vertices to start from
  *@param G Network structure
  *@param lambda Value for density calculation
  */
-void ExpandSeed(set<shared_ptr<string>, cmp_str_ptr> &seed, shared_ptr<network> G, double lambda) {
-    cout << *(*seed.begin()) << ",,,";
-    map<shared_ptr<string>, pair<double, double>, cmp_str_ptr> members, neighbors;
-    set<shared_ptr<string>, cmp_str_ptr> fringe;
-    set<shared_ptr<string>, cmp_str_ptr>::iterator it_s;
-    map<shared_ptr<string>, double, cmp_str_ptr>::iterator it_n;
-    map<shared_ptr<string>, pair<double, double>, cmp_str_ptr>::iterator it_d, it_d2;
+void ExpandSeed(set<int> &seed, const csr_network &G, double lambda) {
+    static thread_local expansion_state S;
+    S.Prepare(G.VertexCount());
+    set<int>::iterator it_s;
 
     double seed_win = 0, seed_wout = 0;
+    int seed_size = seed.size();
+
+    for (it_s = seed.begin(); it_s != seed.end(); it_s++) S.Set(*it_s, expansion_state::MEMBER, 0, 0);
 
     for (it_s = seed.begin(); it_s != seed.end(); it_s++) {  //Tally members of the seed, calculating individual
         // Win and Wout measures and noting neighborhood
-        map<shared_ptr<string>, double, cmp_str_ptr> N = G->GetNeighborhood(*it_s);
         double Win = 0, Wout = 0;
-        for (it_n = N.begin(); it_n != N.end(); it_n++) {
-            if (seed.find(it_n->first) != seed.end()) {     //If the neighbor is also in the seed, increase weight_in
-                Win += it_n->second;
-                seed_win += it_n->second;
+        for (int e = G.EdgesBegin(*it_s); e < G.EdgesEnd(*it_s); e++) {
+            const int n = G.Target(e);
+            if (S.where[n] == expansion_state::MEMBER) {     //If the neighbor is also in the seed, increase weight_in
+                Win += G.Weight(e);
+                seed_win += G.Weight(e);
             } else {                                            //Else increase weight out
-                Wout += it_n->second;
-                seed_wout += it_n->second;
-                fringe.insert(it_n->first);
+                Wout += G.Weight(e);
+                seed_wout += G.Weight(e);
+                if (S.where[n] == expansion_state::NONE) S.Set(n, expansion_state::NEIGHBOR, 0, 0);
             }
         }
 
-        members.insert(pair<shared_ptr<string>, pair<double, double> >(shared_ptr<string>(*it_s),
-                                                                       pair<double, double>(Win, Wout)));
-        //cout << **it_s << " : " << Win << " " << Wout << endl;
+        S.win[*it_s] = Win;
+        S.wout[*it_s] = Wout;
     }
 
     seed_win /= 2.0;  //Internal edges were counted twice (assumed undirected)
 
-    //cout << "Fringe: " << endl;
-
-    for (it_s = fringe.begin(); it_s != fringe.end(); it_s++) { //Tally same information for neighborhood
-        map<shared_ptr<string>, double, cmp_str_ptr> N = G->GetNeighborhood(*it_s);
+    vector<int> to_check;
+    S.Collect(expansion_state::NEIGHBOR, G, to_check);
+    for (unsigned int i = 0; i < to_check.size(); i++) { //Tally same information for neighborhood
+        const int n = to_check[i];
         double Win = 0, Wout = 0;
-        for (it_n = N.begin(); it_n != N.end(); it_n++) {
-            if (seed.find(it_n->first) != seed.end()) {
-                Win += it_n->second;
+        for (int e = G.EdgesBegin(n); e < G.EdgesEnd(n); e++) {
+            if (S.where[G.Target(e)] == expansion_state::MEMBER) {
+                Win += G.Weight(e);
             } else {
-                Wout += it_n->second;
+                Wout += G.Weight(e);
             }
         }
-
-        neighbors.insert(pair<shared_ptr<string>, pair<double, double> >(shared_ptr<string>(*it_s),
-                                                                         pair<double, double>(Win, Wout)));
-        //cout << **it_s << " : " << Win << " " << Wout << endl;
+        S.win[n] = Win;
+        S.wout[n] = Wout;
     }
 
     bool changed = true;
 
-    srand(time(NULL));
-
     //cout << endl << " NEW SEED " << endl << endl;
 
     //While the seed is changing, add new members and remove poor members
     while (changed) {
         changed = false;
-        vector<shared_ptr<string> > to_check;
-        vector<set<shared_ptr<string>, cmp_str_ptr> > order_by_degree;
-        set<shared_ptr<string>, cmp_str_ptr>::iterator it_deg;
-
-        for (it_d = neighbors.begin(); it_d != neighbors.end(); it_d++) {
-            int deg = G->Degree(it_d->first);
-            if (order_by_degree.size() < deg + 1) order_by_degree.resize(deg + 1);
-            order_by_degree[deg].insert(it_d->first);
-        }
-
-        for (int k = 0; k < order_by_degree.size(); k++) {
-            for (it_deg = order_by_degree[k].begin(); it_deg != order_by_degree[k].end(); it_deg++) {
-                to_check.push_back(*it_deg);
-            }
-        }
-
-        /*for ( it_d = neighbors.begin(); it_d != neighbors.end(); it_d++ ){
-          to_check.push_back(it_d->first);
-        }
-
-        random_shuffle ( to_check.begin(), to_check.end() );   ///Get the neighborhood in a random order*/
+        S.Collect(expansion_state::NEIGHBOR, G, to_check);
 
         for (unsigned int i = 0; i < to_check.size(); i++) { // Go through all the neighbors
-            it_d = neighbors.find(to_check[i]);
+            const int v = to_check[i];
 
-            //cout << *to_check[i] << " to be checked for addition : " << seed_win << " " << seed_wout << " " << it_d->second.first << " " << it_d->second.second << " " << CalcDensity(seed.size(), seed_win, seed_wout, lambda) << " " <<  CalcDensity(seed.size() + 1, seed_win + it_d->second.first, seed_wout + it_d->second.second - it_d->second.first, lambda) << endl;
+            //cout << G.Name(v) << " to be checked for addition : " << seed_win << " " << seed_wout << " " << S.win[v] << " " << S.wout[v] << " " << CalcDensity(seed_size, seed_win, seed_wout, lambda) << " " <<  CalcDensity(seed_size + 1, seed_win + S.win[v], seed_wout + S.wout[v] - S.win[v], lambda) << endl;
 
-            if (CalcDensity(seed.size(), seed_win, seed_wout, lambda) <
-                CalcDensity(seed.size() + 1, seed_win + it_d->second.first,
-                            seed_wout + it_d->second.second - it_d->second.first, lambda)) {
+            if (CalcDensity(seed_size, seed_win, seed_wout, lambda) <
+                CalcDensity(seed_size + 1, seed_win + S.win[v], seed_wout + S.wout[v] - S.win[v], lambda)) {
                 //If the density would increase by includeing the vertex - do it
                 //cout << "...Added" << endl;
                 changed = true; //Mark the change in seed
-                seed_win += it_d->second.first;
-                seed_wout = seed_wout - it_d->second.first + it_d->second.second;
-                seed.insert(it_d->first);  //Update seed
-                members.insert(pair<shared_ptr<string>, pair<double, double> >(it_d->first, it_d->second));
-                neighbors.erase(to_check[i]); //Update local trackers
+                seed_win += S.win[v];
+                seed_wout = seed_wout - S.win[v] + S.wout[v];
+                seed_size++;
+                S.where[v] = expansion_state::MEMBER; //Update seed
 
                 //UPDATE MEMBER AND NEIGHBOR LISTS
                 // The Win and Wout values of vertices connected to the added vertex have changed...
-                map<shared_ptr<string>, double, cmp_str_ptr> N = G->GetNeighborhood(to_check[i]);
-
-                for (it_n = N.begin(); it_n != N.end(); it_n++) {
-                    if ((it_d2 = members.find(it_n->first)) != members.end()) { //Update member
-                        it_d2->second.first += it_n->second;
-                        it_d2->second.second -= it_n->second;
-                    } else if ((it_d2 = neighbors.find(it_n->first)) != neighbors.end()) { //Update current neighbor
-                        it_d2->second.first += it_n->second;
-                        it_d2->second.second -= it_n->second;
+                for (int e = G.EdgesBegin(v); e < G.EdgesEnd(v); e++) {
+                    const int n = G.Target(e);
+                    if (S.where[n] != expansion_state::NONE) { //Update member or current neighbor
+                        S.win[n] += G.Weight(e);
+                        S.wout[n] -= G.Weight(e);
                     } else { //Add new neighbor
-                        map<shared_ptr<string>, double, cmp_str_ptr> N2 = G->GetNeighborhood(it_n->first);
-                        map<shared_ptr<string>, double, cmp_str_ptr>::iterator it_d3;
                         double newWin = 0, newWout = 0;
-                        for (it_d3 = N2.begin(); it_d3 != N2.end(); it_d3++) {
-                            if (members.find(it_d3->first) != members.end()) newWin += it_d3->second;
-                            else newWout += it_d3->second;
+                        for (int e2 = G.EdgesBegin(n); e2 < G.EdgesEnd(n); e2++) {
+                            if (S.where[G.Target(e2)] == expansion_state::MEMBER) newWin += G.Weight(e2);
+                            else newWout += G.Weight(e2);
                         }
-
-                        neighbors.insert(pair<shared_ptr<string>, pair<double, double> >(it_n->first,
-                                                                                         pair<double, double>(newWin,
-                                                                                                              newWout)));
+                        S.Set(n, expansion_state::NEIGHBOR, newWin, newWout);
                     }
                 }
             }
-
-            /*Print ( seed );
-            for ( it_d2 = members.begin(); it_d2 != members.end(); it_d2++ ){
-          cout << *(it_d2->first) << "|";
-            }
-            cout << endl;*/
         }
 
         //REPEAT FOR MEMBERS (reversing mathematical signs where necessary, of course)
-        to_check.clear();
-        order_by_degree.clear();
-
-        for (it_d = members.begin(); it_d != members.end(); it_d++) {
-            int deg = G->Degree(it_d->first);
-            if (order_by_degree.size() < deg + 1) order_by_degree.resize(deg + 1);
-            order_by_degree[deg].insert(it_d->first);
-        }
-
-        for (int k = 0; k < order_by_degree.size(); k++) {
-            for (it_deg = order_by_degree[k].begin(); it_deg != order_by_degree[k].end(); it_deg++) {
-                to_check.push_back(*it_deg);
-            }
-        }
-
-        /* for ( it_d = members.begin(); it_d != members.end(); it_d++ ){
-          to_check.push_back(it_d->first);
-        }
-        random_shuffle ( to_check.begin(), to_check.end() );*/
+        S.Collect(expansion_state::MEMBER, G, to_check);
 
         for (unsigned int i = 0; i < to_check.size(); i++) {
-            it_d = members.find(to_check[i]);
+            const int v = to_check[i];
 
-            //cout << *to_check[i] << " to be checked for removal : " << seed_win << " " << seed_wout << " " << it_d->second.first << " " << it_d->second.second << " " << CalcDensity(seed.size(), seed_win, seed_wout, lambda) << " " <<  CalcDensity(seed.size() + 1, seed_win + it_d->second.first, seed_wout + it_d->second.second - it_d->second.first, lambda) << endl;
+            //cout << G.Name(v) << " to be checked for removal : " << seed_win << " " << seed_wout << " " << S.win[v] << " " << S.wout[v] << " " << CalcDensity(seed_size, seed_win, seed_wout, lambda) << " " <<  CalcDensity(seed_size - 1, seed_win - S.win[v], seed_wout - S.wout[v] + S.win[v], lambda) << endl;
 
-            if (CalcDensity(seed.size(), seed_win, seed_wout, lambda) <
-                CalcDensity(seed.size() - 1, seed_win - it_d->second.first,
-                            seed_wout - it_d->second.second + it_d->second.first, lambda)) {
+            if (CalcDensity(seed_size, seed_win, seed_wout, lambda) <
+                CalcDensity(seed_size - 1, seed_win - S.win[v], seed_wout - S.wout[v] + S.win[v], lambda)) {
                 //cout << "...Removed" << endl;
                 changed = true;
-                seed_win -= it_d->second.first;
-                seed_wout = seed_wout + it_d->second.first - it_d->second.second;
-                seed.erase(it_d->first);
-                neighbors.insert(pair<shared_ptr<string>, pair<double, double> >(it_d->first, it_d->second));
-                members.erase(to_check[i]);
+                seed_win -= S.win[v];
+                seed_wout = seed_wout + S.win[v] - S.wout[v];
+                seed_size--;
+                S.where[v] = expansion_state::NEIGHBOR;
 
                 //UPDATE MEMBER AND NEIGHBOR LISTS
-                map<shared_ptr<string>, double, cmp_str_ptr> N = G->GetNeighborhood(to_check[i]);
-
-                for (it_n = N.begin(); it_n != N.end(); it_n++) {
-                    if ((it_d2 = members.find(it_n->first)) != members.end()) { //Update member
-                        it_d2->second.first -= it_n->second;
-                        it_d2->second.second += it_n->second;
-                    } else if ((it_d2 = neighbors.find(it_n->first)) != neighbors.end()) { //Update current neighbor
-                        it_d2->second.first -= it_n->second;
-                        it_d2->second.second += it_n->second;
+                for (int e = G.EdgesBegin(v); e < G.EdgesEnd(v); e++) {
+                    const int n = G.Target(e);
+                    if (S.where[n] != expansion_state::NONE) { //Update member or current neighbor
+                        S.win[n] -= G.Weight(e);
+                        S.wout[n] += G.Weight(e);
                     } //No new neighbors can be added to consider when removing members
                 }
             }
         }
 
         //Get best component to move forward with
-        //map < double, set < shared_ptr < string >, cmp_str_ptr > > comps = Components(seed, G, lambda);
+        //map < double, set < int > > comps = Components(seed, G, lambda);
         //seed = (comps.begin())->second;
 
         //Print ( seed );
     }
+
+    seed.clear();
+    for (unsigned int i = 0; i < S.touched.size(); i++) {
+        if (S.where[S.touched[i]] == expansion_state::MEMBER) seed.insert(S.touched[i]);
+    }
+    S.Clear();
 }
 
 /**
@@ -356,12 +353,11 @@ int main(int argc, char **argv) {
     }
 
     //Load the network
-    temporal_network T;
-    shared_ptr<network> G(T.AddNetwork(inputfile, delimiters, directed));
-    set<set<shared_ptr<string>, cmp_str_ptr>, cmp_set_str> results;
+    csr_network G;
+    G.Load(inputfile, delimiters, directed);
+    vector<set<int> > seeds;
 
-    // Either read seeds from file or go through each vertex as seed.
-    // Expand each seed and record the result
+    // Either read seeds from file or go through each vertex as seed (in the order of their names).
     if (given_seeds) {
         ifstream fin;
         openFileHarsh(&fin, seed_file);
@@ -369,34 +365,61 @@ int main(int argc, char **argv) {
         vector<string> fields;
 
         while (fline_tr(&fin, &fields, seed_delim)) {
-            set<shared_ptr<string>, cmp_str_ptr> seed;
+            set<int> seed;
             for (unsigned int i = 0; i < fields.size(); i++) {
-                seed.insert(shared_ptr<string>(new string(fields[i])));
+                seed.insert(G.AddVertex(fields[i]));
             }
-
-            ExpandSeed(seed, G, lambda);
-            results.insert(seed);
+            seeds.push_back(seed);
         }
-    } else {
-        set<string>::const_iterator it_v = T.getFirstVertex();
-        while (it_v != T.getLastVertex()) {
-            set<shared_ptr<string>, cmp_str_ptr> seed;
-            seed.insert(shared_ptr<string>(new string(*it_v)));
+    }
+    const int seed_count = given_seeds ? seeds.size() : G.VertexCount();
+
+    // Expand the seeds in parallel, a block at a time, and record the distinct results as they converge.
+    // The console output of each seed is kept until its whole block is done, so it comes out in seed order.
+    community_table results;
+    const int block = 4096;
+    for (int first = 0; first < seed_count; first += block) {
+        const int last = min(first + block, seed_count);
+        vector<string> log(last - first);
+
+#pragma omp parallel for schedule(dynamic, 1)
+        for (int i = first; i < last; i++) {
+            set<int> seed;
+            if (given_seeds) seed.swap(seeds[i]);
+            else seed.insert(i);
+            stringstream out;
+            out << G.Name(*seed.begin()) << ",,,";
 
             ExpandSeed(seed, G, lambda);
-            cout << "!!!" << seed.size() << "\t:";
-            for (auto str:seed) {
-                cout << *str << ",";
+            if (!given_seeds) {
+                out << "!!!" << seed.size() << "\t:";
+                for (auto u:seed) {
+                    out << G.Name(u) << ",";
+                }
+                out << endl;
             }
-            cout << endl;
-            results.insert(seed);
+            results.Insert(vector<int>(seed.begin(), seed.end()));
 
-            //cout << seed.size() << endl;
-            ++it_v;
+            log[i - first] = out.str();
+        }
+
+        for (unsigned int i = 0; i < log.size(); i++) {
+            cout << log[i];
+        }
+    }
+
+    //Back to the names, in the order of the names
+    set<set<shared_ptr<string>, cmp_str_ptr>, cmp_set_str> named_results;
+    vector<vector<int> > communities = results.Communities();
+    for (auto iter_tmp = communities.begin(); iter_tmp != communities.end(); ++iter_tmp) {
+        set<shared_ptr<string>, cmp_str_ptr> named;
+        for (auto iter_tmp2 = (*iter_tmp).begin(); iter_tmp2 != (*iter_tmp).end(); ++iter_tmp2) {
+            named.insert(shared_ptr<string>(new string(G.Name(*iter_tmp2))));
         }
+        named_results.insert(named);
     }
 
-    for (auto iter_tmp = results.begin(); iter_tmp != results.end(); ++iter_tmp) {
+    for (auto iter_tmp = named_results.begin(); iter_tmp != named_results.end(); ++iter_tmp) {
         for (auto iter_tmp2 = (*iter_tmp).begin(); iter_tmp2 != (*iter_tmp).end(); ++iter_tmp2) {
             cout << *(*iter_tmp2) << ",";
         }
@@ -405,7 +428,7 @@ int main(int argc, char **argv) {
     //Print resulting communities
     set<set<shared_ptr<string>, cmp_str_ptr>, cmp_set_str>::iterator it_ss;
     ofstream fout(outputfile.c_str());
-    for (it_ss = results.begin(); it_ss != results.end(); it_ss++) {
+    for (it_ss = named_results.begin(); it_ss != named_results.end(); it_ss++) {
         Print(*it_ss, fout, output_delim);
     }
     fout.close();
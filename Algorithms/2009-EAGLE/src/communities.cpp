@@ -36,6 +36,9 @@ Communities::Communities(igraph_t *graph) {
 
     // questa è una costante ricorrente
     factor = 0.5 / ((double) igraph_ecount(graph));
+
+    // da qui in avanti vicini ed edge si leggono dall'istantanea
+    csr = std::make_shared<const CSRGraph>(graph);
 }
 
 
@@ -51,6 +54,7 @@ Communities::~Communities() {
 
 Communities::Communities(const Communities &c) {
     this->graph = c.graph;
+    this->csr = c.csr;
     this->communities = c.communities;
     this->counter = c.counter;
     this->keys = c.keys;
@@ -58,6 +62,7 @@ Communities::Communities(const Communities &c) {
 
 #ifdef EQ_HARD
     this->mmap = c.mmap;
+    this->eq = c.eq;
 #endif
 
     unsigned int vs = igraph_vcount(graph);
@@ -94,69 +99,30 @@ bool Communities::has(CID i) {
 ////////////////////////////////////////////////////////////////////////////////
 // utilità
 ////////////////////////////////////////////////////////////////////////////////
-// FIXME: inserire il controllo degli errori
 unsigned int Communities::getCommunityInternalEdges(unsigned int s) {
-    int err;
-
-    igraph_vector_t *v = communities[s]->toVector();
-    igraph_vs_t *vs = communities[s]->toVertexSelector(v);
-
-    //creazione sottografo dal vertex_selector;
-    igraph_t subgraph;
-    err = igraph_subgraph(graph, &subgraph, *vs);
-
-    // quello che ci interessa realmente
-    unsigned int e = igraph_ecount(&subgraph);
-
-    // queste funzioni non restituiscono niente
-    igraph_vs_destroy(vs);
-    igraph_vector_destroy(v);
-    delete vs;
-    delete v;
-    igraph_destroy(&subgraph);
+    NodeSetPtr set = communities[s]->set;
+    unsigned int e = 0;
+
+    // ogni edge interno viene visto da entrambi gli estremi, lo contiamo dal
+    // nodo con indice minore (o una volta sola se è un self loop)
+    BOOST_FOREACH(Node v, *set) {
+                    for (const Node *w = csr->begin(v); w != csr->end(v); w++)
+                        if (*w >= v && set->find(*w) != set->end()) e++;
+                }
 
     return e;
 }
 
-// FIXME: inserire il controllo degli errori
 unsigned int Communities::getCommunityBoundaryEdges(unsigned int s) {
-    int err;
+    NodeSetPtr set = communities[s]->set;
     unsigned int o = 0;
 
-    igraph_vector_t *v = communities[s]->toVector();
-    igraph_vs_t *vs = communities[s]->toVertexSelector(v);
-
-    igraph_vit_t vit;
-    igraph_vit_create(graph, *vs, &vit);
-
-    unsigned int cSize = communities[s]->set->size();
-
-    igraph_vector_ptr_t p;
-    err = igraph_vector_ptr_init(&p, cSize);
-    err = igraph_neighborhood(graph, &p, *vs, 1, IGRAPH_ALL, 1);
-    // la componente i-esima di p contiene l'elenco di vicini di ordine 1
-    // dell'i-esimo nodo della community (quindi anche sé stesso)
-
     //conteggio edge che escono dalla community
-    for (unsigned int i = 0; i < cSize; i++)  //per ogni vertice della community
-    {
-        igraph_vector_t *vv = (igraph_vector_t *) igraph_vector_ptr_e(&p, i);
-
-        // per ogni vertice vicino di i
-        for (int l = 0; l < igraph_vector_size(vv); l++) {
-            //se non appartiene alla community, incrementa o
-            if (!ownership(VECTOR(*vv)[l], s))
-                o++;
-        }
-    }
-
-    igraph_vit_destroy(&vit);
-    igraph_vs_destroy(vs);
-    igraph_vector_destroy(v);
-    delete vs;
-    delete v;
-
-    igraph_vector_ptr_destroy(&p);
+    BOOST_FOREACH(Node v, *set) {
+                    // per ogni vertice vicino, se non appartiene alla community incrementa o
+                    for (const Node *w = csr->begin(v); w != csr->end(v); w++)
+                        if (set->find(*w) == set->end()) o++;
+                }
 
     return o;
 }
@@ -347,8 +313,58 @@ void Communities::prepareForEAGLE() {
 }
 
 void Communities::precalculateData() {
-    BOOST_FOREACH(CommunitiesMap::value_type
-                          cp, communities)cp.second->update(graph, degrees, membership);
+    // ogni community scrive solo i propri dati, e l'istantanea è in sola lettura
+    int tempSize = keys.size();
+    CommunityPtr *temporary = new CommunityPtr[tempSize];
+    int tempIter = 0;
+    BOOST_FOREACH(CID c, keys) temporary[tempIter++] = communities[c];
+
+#pragma omp parallel for schedule(dynamic) default(shared)
+    for (int i = 0; i < tempSize; i++)
+        temporary[i]->update(*csr, degrees, membership);
+
+    delete[] temporary;
+
+#ifdef EQ_HARD
+    // da qui in avanti eq viene aggiornato ad ogni merge
+    eq = 0.0;
+    BOOST_FOREACH(CID c, keys) eq += communities[c]->cf - factor * communities[c]->dm;
+#endif
+}
+
+void Communities::neighbourSimilarities(CID c, vector<pair<CID, double> > &result, bool only_greater) {
+    result.clear();
+    CommunityPtr a = get(c);
+
+#ifdef EQ_HARD
+    // per ogni community vicina: numero di coppie adiacenti (v in c, w in b) e
+    // somma dei quadrati dei gradi dei nodi in comune
+    boost::unordered_map<CID, pair<double, double> > acc;
+
+    // si usa solo find su mmap e l'istantanea è in sola lettura, così la
+    // funzione può girare su più thread
+    BOOST_FOREACH(Node v, *a->set) {
+                    MembershipMap::const_iterator mv = mmap.find(v);
+                    BOOST_FOREACH(CID b, mv->second)acc[b].second += (double) degrees[v] * degrees[v];
+
+                    for (const Node *w = csr->begin(v); w != csr->end(v); w++) {
+                        if (*w == v) continue;
+                        MembershipMap::const_iterator mw = mmap.find(*w);
+                        if (mw == mmap.end()) continue;
+                        BOOST_FOREACH(CID b, mw->second)acc[b].first += 1.0;
+                    }
+                }
+
+    for (boost::unordered_map<CID, pair<double, double> >::const_iterator it = acc.begin(); it != acc.end(); it++) {
+        if (it->first == c || (only_greater && it->first < c)) continue;
+        CommunityPtr b = get(it->first);
+        double s = it->second.first - factor * ((double) a->comdegree * (double) b->comdegree - it->second.second);
+        result.push_back(make_pair(it->first, s));
+    }
+#else
+    // senza mmap non sappiamo quali sono le community vicine, le proviamo tutte
+    BOOST_FOREACH(CID b, keys)if (b != c && (!only_greater || b > c)) result.push_back(make_pair(b, similarity(c, b)));
+#endif
 }
 
 unsigned int Communities::merge(unsigned int a, unsigned int b, bool hasComms) {
@@ -360,6 +376,20 @@ unsigned int Communities::merge(unsigned int a, unsigned int b, bool hasComms) {
     // vettore membership
     CommunityPtr is = get(a)->intersect(get(b));
 
+#ifdef EQ_HARD
+    // a e b escono dalla suddivisione
+    eq -= get(a)->cf - factor * get(a)->dm;
+    eq -= get(b)->cf - factor * get(b)->dm;
+
+    // cambia la membership solo dei nodi dell'intersezione, quindi vanno
+    // aggiornate soltanto le altre communities che contengono questi nodi
+    set<CID> toUpdate;
+    BOOST_FOREACH(Node n, *is->set)
+                    BOOST_FOREACH(CID cid, mmap[n])if (cid != a && cid != b) toUpdate.insert(cid);
+
+    BOOST_FOREACH(CID cid, toUpdate)loseMembership(get(cid), *is->set);
+#endif
+
     // questo fa cambiare membership, ed è necessario fare l'update di tutte le
     // communities che hanno questi nodi
     BOOST_FOREACH(Node n, *is->set)membership[n]--;
@@ -384,34 +414,45 @@ unsigned int Communities::merge(unsigned int a, unsigned int b, bool hasComms) {
     communities.erase(b);
     keys.erase(b);
 
+    m->update(*csr, degrees, membership);
 
 #ifdef EQ_HARD
-    // qui mettiamo i CID delle communities da aggiornare
-    set<CID> toUpdate;
-
-    // popliamo update, prendendo tutte le communities che hanno nodi la cui
-    // membership è cambiata (e questi per forza sono quelli dell'intersezione)
-    BOOST_FOREACH(Node n, *m->set)
-                    BOOST_FOREACH(CID cid, mmap[n])toUpdate.insert(cid);
-
-    int upSize = toUpdate.size();
-    CommunityPtr *temp = new CommunityPtr[upSize];
-    int upc = 0;
-
-    // a questo punto chiamiamo l'update solo su queste communities
-    BOOST_FOREACH(CID cid, toUpdate)temp[upc++] = get(cid);
-
-#pragma omp parallel for if (upSize > 10) default(shared)
-    for (int iterator = 0; iterator < upSize; iterator++)
-        temp[iterator]->update(graph, degrees, membership);
-
-#else
-    m->update(graph, degrees, membership);
+    eq += m->cf - factor * m->dm;
 #endif
 
     return r;
 }
 
+#ifdef EQ_HARD
+void Communities::loseMembership(CommunityPtr c, const NodeSet &lost) {
+    eq -= c->cf - factor * c->dm;
+
+    // cf somma 1/(membership[v] * membership[w]) sulle coppie ordinate di nodi
+    // adiacenti della community: cambiano solo le coppie con almeno un nodo in
+    // lost. Le coppie con un solo nodo in lost sono contate due volte, quelle
+    // con entrambi una volta per ciascun verso.
+    BOOST_FOREACH(Node v, lost) {
+                    if (c->set->find(v) == c->set->end()) continue;
+
+                    double xv = 1.0 / membership[v];
+                    double nv = 1.0 / (membership[v] - 1);
+                    c->dw += degrees[v] * (nv - xv);
+
+                    for (const Node *wi = csr->begin(v); wi != csr->end(v); wi++) {
+                        Node w = *wi;
+                        if (c->set->find(w) == c->set->end()) continue;
+
+                        double xw = 1.0 / membership[w];
+                        if (lost.find(w) != lost.end()) c->cf += nv / (membership[w] - 1) - xv * xw;
+                        else c->cf += 2.0 * (nv - xv) * xw;
+                    }
+                }
+
+    c->dm = c->dw * c->dw;
+    eq += c->cf - factor * c->dm;
+}
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 // grim, forgotten and frostbitten
 ////////////////////////////////////////////////////////////////////////////////    
@@ -5,6 +5,9 @@
 
 #include <string>
 #include <set>
+#include <vector>
+#include <utility>
+#include <memory>
 
 #include <iostream>
 
@@ -14,6 +17,8 @@
 
 #include <igraph.h>
 
+#include "csr_graph.h"
+
 // versione hardcore di valutazione EQ, utilizza accelerazione su cf e dm,
 // introduce delle correzioni in SetCommunities::merge per mantenere cf e dm 
 // aggiornati
@@ -63,6 +68,9 @@ struct Community {
 
     /// grado pesato della community
     double dm;
+
+    /// somma dei gradi dei nodi divisi per la membership (dm è il suo quadrato)
+    double dw;
 #endif
 
     /// Distruttore della classe, si occupa di cancellare set.
@@ -110,11 +118,11 @@ struct Community {
     /**
      Aggiorna tutti i dati precalcolati, a seconda di quali sono presenti.
 
-     param graph Puntatore al grafo utilizzato.
+     param graph Istantanea CSR del grafo utilizzato.
      param degrees Puntatore costante all'array dei gradi dei nodi del grafo.
      param membership Puntatore costante all'array dei gradi di appartenenza dei nodi del grafo.
      */
-    void update(igraph_t *graph, const unsigned int *degrees, const unsigned int *membership);
+    void update(const CSRGraph &graph, const unsigned int *degrees, const unsigned int *membership);
 
     /**
      Restituisce un vettore di igraph con riferimento ai nodi della community.
@@ -153,13 +161,12 @@ NodeSetPtr Community::toSet() const {
 }
 
 inline
-void Community::update(igraph_t *graph, const unsigned int *degrees, const unsigned int *membership) {
+void Community::update(const CSRGraph &graph, const unsigned int *degrees, const unsigned int *membership) {
     comdegree = 0;
 
 #ifdef EQ_HARD
     cf = 0.0;
-    dm = 0.0;
-    igraph_bool_t result;
+    dw = 0.0;
 #endif
 
 
@@ -167,17 +174,17 @@ void Community::update(igraph_t *graph, const unsigned int *degrees, const unsig
                     comdegree += degrees[v];
 
 #ifdef EQ_HARD
-                    dm += (double) degrees[v] / (double) membership[v];
+                    dw += (double) degrees[v] / (double) membership[v];
 
-                    BOOST_FOREACH(Node w, *set) {
-                                    igraph_are_connected(graph, v, w, &result);
-                                    cf += ((double) result) / (membership[v] * membership[w]);
-                                }
+                    // basta scorrere i vicini di v, gli altri nodi darebbero 0
+                    for (const Node *w = graph.begin(v); w != graph.end(v); w++)
+                        if (set->find(*w) != set->end())
+                            cf += 1.0 / (membership[v] * membership[*w]);
 #endif
                 }
 
 #ifdef EQ_HARD
-    dm = dm * dm;
+    dm = dw * dw;
 #endif
 }
 
@@ -252,6 +259,9 @@ protected:
     /// Puntatore al grafo igraph che ha queste communities
     igraph_t *graph;
 
+    /// Istantanea CSR del grafo, condivisa tra le copie
+    std::shared_ptr<const CSRGraph> csr;
+
     /// Array contenente i gradi dei nodi del grafo
     unsigned int *degrees;
 
@@ -270,6 +280,17 @@ protected:
 #ifdef EQ_HARD
     /// Indica a quali communities appartiene ciascun nodo.
     MembershipMap mmap;
+
+    /// EQ della suddivisione attuale, aggiornato ad ogni merge
+    double eq;
+
+    /**
+     Aggiorna cf e dm di una community quando i nodi di lost perdono una
+     membership, insieme al contributo della community in eq. Va chiamata prima
+     di decrementare membership, e costa quanto i vicini dei nodi di lost che
+     appartengono alla community.
+     */
+    void loseMembership(CommunityPtr c, const NodeSet &lost);
 #endif
 
     /// Restituisce un puntatore alla community c.
@@ -321,6 +342,9 @@ public:
     /// Restituisce true se i due nodi sono connessi
     bool areConnected(Node a, Node b);
 
+    /// Restituisce l'istantanea CSR del grafo
+    const CSRGraph &getSnapshot() const;
+
     /** Genera un resoconto sullo stato attuale delle communities.
      param verbose Indica se mostrare i nodi che appartengono alle communities.
      */
@@ -370,15 +394,31 @@ public:
     ////////////////////////////////////////////////////////////////////////////    
     // Metodi di supporto ad EAGLE
     ////////////////////////////////////////////////////////////////////////////    
-    /// Calcola l'EQ della suddivisione attuale
+    /// Restituisce l'EQ della suddivisione attuale (richiede precalculateData)
     double EQ();
 
+    /// Calcola l'EQ della suddivisione attuale da zero, senza usare cf e dm
+    double computeEQ();
+
     /// Aggiunge una community alle altre
     CID registerCommunity(CommunityPtr c);
 
     /// Calcola la similarity tra due community
     double similarity(CID i, CID j);
 
+    /**
+     Calcola la similarity tra c e tutte le community vicine, cioè quelle che
+     condividono nodi con c o hanno nodi adiacenti ad essa. Con only_greater
+     vengono considerate solo le community con CID maggiore di c.
+     */
+    void neighbourSimilarities(CID c, std::vector<std::pair<CID, double> > &result, bool only_greater = false);
+
+    /// Restituisce la somma dei gradi dei nodi di una community
+    unsigned int getComdegree(CID s);
+
+    /// Restituisce il fattore di scala di EAGLE
+    double getFactor() const;
+
     /// Fa il merge tra due community
     unsigned int merge(CID a, CID b, bool hasComms);
 
@@ -420,12 +460,24 @@ unsigned int Communities::getDegree(Node node) {
     return degrees[node];
 }
 
+inline
+unsigned int Communities::getComdegree(CID s) {
+    return communities[s]->comdegree;
+}
+
+inline
+double Communities::getFactor() const {
+    return factor;
+}
+
 inline
 bool Communities::areConnected(Node a, Node b) {
-    igraph_bool_t result;
-    igraph_are_connected(graph, a, b, &result);
+    return csr->areConnected(a, b);
+}
 
-    return result;
+inline
+const CSRGraph &Communities::getSnapshot() const {
+    return *csr;
 }
 
 inline
@@ -482,7 +534,7 @@ inline
 double Communities::cutRatio(CID s) {
     double n = (double) communities[s]->communitySize;
     double c = (double) communities[s]->communityBoundaryEdges;
-    return c / (n * (igraph_vcount(graph) - n));
+    return c / (n * (csr->vcount() - n));
 }
 
 inline
@@ -490,7 +542,7 @@ double Communities::normalizedCut(CID s) {
     double m = (double) communities[s]->communityInternalEdges;
     double c = (double) communities[s]->communityBoundaryEdges;
     double r1 = conductance(s);
-    double r2 = c / (2.0 * (igraph_ecount(graph) - m) + c);
+    double r2 = c / (2.0 * (csr->ecount() - m) + c);
     return r1 + r2;
 }
 
@@ -511,33 +563,19 @@ double Communities::scaledLinkDensity(CID s) {
 inline
 double Communities::maxODF(CID s) {
     double maximumODF = 0.0;
-    int err;
     double ODF;
     CommunityPtr a = communities[s];
 
     BOOST_FOREACH(unsigned int v, *a->set) {
-                    igraph_vs_t vs;
-                    igraph_vit_t vit;
-                    // qualcosa non torna nella firma di questa funzione =|
-                    err = igraph_vs_adj(&vs, v, IGRAPH_ALL);
-
-                    err = igraph_vit_create(graph, vs, &vit);
-
-                    double t_degree = (double) IGRAPH_VIT_SIZE(vit); //grado del nodo
-                    //unsigned int t_degree = degrees[v];
+                    double t_degree = (double) csr->neighbourCount(v); //grado del nodo
                     double o_degree = 0.0; //numero nodi adiacenti esterni alla community
 
-                    while (!IGRAPH_VIT_END(vit)) {
-                        if (!ownership((long int) IGRAPH_VIT_GET(vit), s)) o_degree += 1.0;
-                        IGRAPH_VIT_NEXT(vit);
-                    }
+                    for (const Node *w = csr->begin(v); w != csr->end(v); w++)
+                        if (a->set->find(*w) == a->set->end()) o_degree += 1.0;
 
                     ODF = o_degree / t_degree;
                     if (ODF > maximumODF)
                         maximumODF = ODF;
-
-                    igraph_vs_destroy(&vs);
-                    igraph_vit_destroy(&vit);
                 }
     return maximumODF;
 }
@@ -545,33 +583,19 @@ double Communities::maxODF(CID s) {
 inline
 double Communities::avgODF(CID s) {
     double averageODF = 0.0;
-    // double ODF;
     double n = (double) communities[s]->communitySize;
     CommunityPtr a = communities[s];
-    int err;
 
     BOOST_FOREACH(Node v, *a->set) {
-                    igraph_vs_t vs;
-                    igraph_vit_t vit;
-
-                    //restituizione nodi adiacenti
-                    err = igraph_vs_adj(&vs, v, IGRAPH_ALL);
-                    err = igraph_vit_create(graph, vs, &vit);
-
-                    double t_degree = (double) IGRAPH_VIT_SIZE(vit); //grado del nodo
+                    double t_degree = (double) csr->neighbourCount(v); //grado del nodo
                     double o_degree = 0.0; //numero nodi adiacenti esterni alla community
 
-                    while (!IGRAPH_VIT_END(vit)) {
-                        //verifica se i nodi appartengono alla community s
-                        if (!ownership((long int) IGRAPH_VIT_GET(vit), s)) o_degree += 1.0;
-                        IGRAPH_VIT_NEXT(vit);
-                    }
+                    //verifica se i nodi adiacenti appartengono alla community s
+                    for (const Node *w = csr->begin(v); w != csr->end(v); w++)
+                        if (a->set->find(*w) == a->set->end()) o_degree += 1.0;
 
                     double ODF = o_degree / t_degree;
                     averageODF += ODF;
-
-                    igraph_vs_destroy(&vs);
-                    igraph_vit_destroy(&vit);
                 }
 
     return averageODF / n;
@@ -583,29 +607,14 @@ double Communities::flakeODF(CID s) {
     double n = (double) communities[s]->communitySize;
     CommunityPtr a = communities[s];
 
-    int err;
     BOOST_FOREACH(Node v, *a->set) {
-                    igraph_vs_t vs;
-                    igraph_vit_t vit;
-
-                    //restituizione nodi adiacenti
-                    err = igraph_vs_adj(&vs, v, IGRAPH_ALL);
-                    err = igraph_vit_create(graph, vs, &vit);
-
-                    double t_degree = (double) IGRAPH_VIT_SIZE(vit); //grado del nodo
+                    double t_degree = (double) csr->neighbourCount(v); //grado del nodo
                     double i_degree = 0.0;                   //numero nodi adiacenti interni alla community
 
-                    while (!IGRAPH_VIT_END(vit)) {
-                        if (ownership((long int) IGRAPH_VIT_GET(vit),
-                                      s)) //verifica se i nodi appartengono alla community s
-                            i_degree += 1.0;
-                        IGRAPH_VIT_NEXT(vit);
-                    }
+                    for (const Node *w = csr->begin(v); w != csr->end(v); w++)
+                        if (a->set->find(*w) != a->set->end()) i_degree += 1.0;
 
                     if (i_degree < (t_degree / 2)) flkODF++;
-
-                    igraph_vs_destroy(&vs);
-                    igraph_vit_destroy(&vit);
                 }
     return flkODF / n;
 }
@@ -613,6 +622,15 @@ double Communities::flakeODF(CID s) {
 
 inline
 double Communities::EQ() {
+#ifdef EQ_HARD
+    return eq;
+#else
+    return computeEQ();
+#endif
+}
+
+inline
+double Communities::computeEQ() {
     double r = 0;
 
     const int tempSize = keys.size();
@@ -636,9 +654,16 @@ double Communities::EQ() {
 #endif
 
 #ifdef EQ_HARD
+    // le community sono condivise con le copie, quindi cf e dm vengono
+    // ricalcolati su una community temporanea con lo stesso set
 #pragma omp parallel for default(shared) reduction(+:r)
-    for (int i = 0; i < tempSize; i++)
-        r += temporary[i]->cf - factor * temporary[i]->dm;
+    for (int i = 0; i < tempSize; i++) {
+        Community t;
+        t.set = temporary[i]->set;
+        t.update(*csr, degrees, membership);
+        r += t.cf - factor * t.dm;
+        t.set = NULL;
+    }
 #endif
 
     delete[] temporary;
@@ -0,0 +1,41 @@
+
+#include <algorithm>
+
+#include "csr_graph.h"
+
+using namespace std;
+
+CSRGraph::CSRGraph(igraph_t *graph) {
+    unsigned int vc = igraph_vcount(graph);
+    edges = igraph_ecount(graph);
+
+    offsets.reserve(vc + 1);
+    adjacency.reserve(2 * edges);
+    offsets.push_back(0);
+
+    igraph_vector_t neis;
+    igraph_vector_init(&neis, 0);
+
+    for (unsigned int v = 0; v < vc; v++) {
+        igraph_neighbors(graph, &neis, v, IGRAPH_ALL);
+
+        // igraph ripete i vicini collegati da più edge, a noi basta sapere se
+        // due nodi sono connessi
+        long int n = igraph_vector_size(&neis);
+        for (long int l = 0; l < n; l++) adjacency.push_back((unsigned int) VECTOR(neis)[l]);
+
+        vector<unsigned int>::iterator first = adjacency.begin() + offsets.back();
+        sort(first, adjacency.end());
+        adjacency.erase(unique(first, adjacency.end()), adjacency.end());
+
+        offsets.push_back(adjacency.size());
+    }
+
+    igraph_vector_destroy(&neis);
+}
+
+bool CSRGraph::areConnected(unsigned int a, unsigned int b) const {
+    // si cerca nella lista più corta
+    if (neighbourCount(a) > neighbourCount(b)) swap(a, b);
+    return binary_search(begin(a), end(a), b);
+}
@@ -0,0 +1,80 @@
+
+#ifndef __CSRGRAPH_H
+#define __CSRGRAPH_H
+
+#include <vector>
+
+#include <igraph.h>
+
+/** Istantanea CSR del grafo
+ Copia in sola lettura della struttura del grafo in formato compressed sparse
+ row: i vicini di ciascun nodo sono memorizzati ordinati e senza duplicati in un
+ unico array, e offsets indica dove inizia la lista di ciascun nodo.
+ Viene costruita una volta sola, dopodiché tutte le statistiche sulle community
+ la interrogano al posto di igraph: non alloca niente e può essere letta da più
+ thread contemporaneamente.
+ */
+class CSRGraph {
+private:
+    /// Posizione in adjacency della lista dei vicini di ciascun nodo (vcount + 1)
+    std::vector<unsigned int> offsets;
+
+    /// Liste dei vicini, una dopo l'altra
+    std::vector<unsigned int> adjacency;
+
+    /// Numero di edge del grafo originale
+    unsigned int edges;
+
+public:
+    /**
+     Costruisce l'istantanea di un grafo di igraph.
+
+     param graph Puntatore al grafo da copiare.
+     */
+    CSRGraph(igraph_t *graph);
+
+    /// Numero di nodi
+    unsigned int vcount() const;
+
+    /// Numero di edge
+    unsigned int ecount() const;
+
+    /// Numero di vicini distinti di un nodo
+    unsigned int neighbourCount(unsigned int v) const;
+
+    /// Puntatore al primo vicino di un nodo
+    const unsigned int *begin(unsigned int v) const;
+
+    /// Puntatore alla fine della lista dei vicini di un nodo
+    const unsigned int *end(unsigned int v) const;
+
+    /// Restituisce true se i due nodi sono connessi
+    bool areConnected(unsigned int a, unsigned int b) const;
+};
+
+inline
+unsigned int CSRGraph::vcount() const {
+    return offsets.size() - 1;
+}
+
+inline
+unsigned int CSRGraph::ecount() const {
+    return edges;
+}
+
+inline
+unsigned int CSRGraph::neighbourCount(unsigned int v) const {
+    return offsets[v + 1] - offsets[v];
+}
+
+inline
+const unsigned int *CSRGraph::begin(unsigned int v) const {
+    return adjacency.data() + offsets[v];
+}
+
+inline
+const unsigned int *CSRGraph::end(unsigned int v) const {
+    return adjacency.data() + offsets[v + 1];
+}
+
+#endif // __CSRGRAPH_H
@@ -4,7 +4,8 @@
 #include <boost/archive/text_oarchive.hpp>
 
 #include "eagle.h"
-#include "max_cache.h"
+#include "similarity_heap.h"
+#include "maximal_cliques.h"
 
 
 using namespace std;
@@ -19,47 +20,29 @@ void EAGLE::getInitialCommunities() {
     int vs = igraph_vcount(graph);
     cout << "Numero nodi: " << vs << endl;
 
-    int output;
-
     // ottieni le maximal cliques
     cout << "maximal_cliques" << endl;
-    igraph_vector_ptr_t cliques; // FIXME: devo essere inizializzato?
-    output = igraph_vector_ptr_init(&cliques, 0);
-    output = igraph_maximal_cliques(graph, &cliques, k, -1);
-    int size = igraph_vector_ptr_size(&cliques);
+    vector<vector<Node> > cliques;
+    maximalCliques(ic->getSnapshot(), k, cliques);
+    int size = cliques.size();
     cout << "terminato" << endl;
 
-    // filtra le community più con meno di k elementi, registra i nodi subordinati
+    // registra le clique come community, e i nodi subordinati
     // unused verrà inizializzato con tutti i nodi
     NodeSet unused;
     for (int i = 0; i < vs; i++) unused.emplace(i);
 
     // per ogni clique trovata
     for (int i = 0; i < size; i++) {
-        // aux è un riferimento alla clique, s sarà la sua dimensione
-        igraph_vector_t *aux = (igraph_vector_t *) VECTOR(cliques)[i];
-        int s = igraph_vector_size(aux);
-
-        NodeSet *p = new NodeSet;
-
-        // popoliamola
-        for (int j = 0; j < s; j++) {
-            int node = VECTOR(*aux)[j];
-            p->emplace(node);
-        }
-
-        // se è più piccola di k la saltiamo
-        // if (s < k) continue;
+        // i nodi della clique sono già ordinati
+        NodeSet *p = new NodeSet(cliques[i].begin(), cliques[i].end());
+        vector<Node>().swap(cliques[i]);
 
         ic->addCommunity(p);
 
-        // FIXME: getSet non funziona!
-        // FIXME: verificare se erase fallisce malamente se manca l'elemento
         BOOST_FOREACH(Node node, *p) unused.erase(node);
     }
 
-    igraph_vector_ptr_destroy(&cliques);
-
     // non resta che creare le community per i nodi subordinati
     BOOST_FOREACH(Node node, unused) ic->addCommunity(node);
 }
@@ -68,9 +51,10 @@ Communities *EAGLE::run() {
     getInitialCommunities();
     ic->precalculateData();
 
-    unsigned int dcache = ic->size() * 3;
-    cout << "Dimensione cache: " << dcache << endl;
-    MaxCache cache(dcache);
+    // lo heap contiene le similarity delle coppie di community vicine, e viene
+    // aggiornato solo con le coppie della community nata da ciascun merge
+    SimilarityHeap heap(ic->getFactor());
+    feedHeap(heap);
 
     // Impostiamo best e calcoliamo beq
     Communities *best = new Communities(*ic);
@@ -84,17 +68,10 @@ Communities *EAGLE::run() {
     while (ic->size() > 1) {
         PROGRESS(progress, leap, '.')
 
-        // Se la cache è vuota (e la prima volta che si entra nel ciclo ovviamente
-        // lo è) viene popolata. La funzione feedCache fa esattamente questo.
-        // Se la cache rimane vuota c'è un errore.
-        if (cache.isEmpty()) {
-            cache.clear();
-            feedCache(cache);
-        }
-        assert(!cache.isEmpty());
-
-        // questo invalida già la cache se necessario, ma non la ripopola.
-        Max merge = cache.get();
+        // la coppia di massima similarity tra tutte le community attive
+        Max merge = heap.top();
+        heap.removeCommunity(merge.i, ic->getComdegree(merge.i));
+        heap.removeCommunity(merge.j, ic->getComdegree(merge.j));
 
         // questo fa il merge delle communities, cancellando le vecchie e
         // mantenendo consistente le strutture dati (vedi membership e comdegrees)
@@ -115,13 +92,9 @@ Communities *EAGLE::run() {
             beq = eq;
         }
 
-        // l'update viene fatto così solo se la cache non è vuota: in questo caso
-        // abbiamo ancora il valore massimo dell'insieme (oltre ai successivi), e
-        // quando si espande l'insieme basta controllare se ci sono valori massimi
-        // tra quelli aggiunti, senza ricontrollare tutto. Questo è valido per
-        // qualsiasi passo, e permette all'algoritmo di evitare un calcolo completo
-        // della similarity ad ogni iterazione, altrimenti sarebbe ancora più lento!
-        if (!cache.isEmpty()) updateCache(cache, i);
+        // le similarity delle altre coppie non cambiano con il merge, basta
+        // aggiungere quelle della nuova community
+        updateHeap(heap, i);
 
         progress += 1;
     }
@@ -136,80 +109,43 @@ Communities *EAGLE::run() {
     return best;
 }
 
-void EAGLE::updateCache(MaxCache &cache, unsigned int c) {
-    // copia dei CID in un array temporaneo per openmp
-    set<unsigned int>::const_iterator b = ic->begin();
-    set<unsigned int>::const_iterator e = ic->end();
-
-    // il -1 è perché non vogliamo calcolare la similarity tra c e c.
-    int csize = ic->size() - 1;
-    unsigned int *comms = new unsigned int[csize];
-    unsigned int commc = 0;
-
-    // facciamo la copia, saltando il caso in cui abbiamo *b == c
-    for (; b != e; b++)
-        if (*b != c) comms[commc++] = *b;
+void EAGLE::updateHeap(SimilarityHeap &heap, unsigned int c) {
+    heap.addCommunity(c, ic->getComdegree(c));
 
-    // qui mettiamo i risultati dei thread
-    double *temp = new double[csize];
-
-    // calcoliamo i risultati; avendo l'array senza l'elemento spurio possiamo
-    // fare più in fretta così
-#pragma omp parallel for shared(c, temp, comms)
-    for (int j = 0; j < csize; j++)
-        temp[j] = ic->similarity(c, comms[j]);
-
-    // adesso raccogliamo i risultati
-    for (int j = 0; j < csize; j++)
-        cache.check(c, comms[j], temp[j]);
-
-    // eliminiamo gli array temporanei
-    delete[] comms;
-    delete[] temp;
+    vector<pair<CID, double> > neighbours;
+    ic->neighbourSimilarities(c, neighbours);
+    for (unsigned int j = 0; j < neighbours.size(); j++)
+        heap.push(c, neighbours[j].first, neighbours[j].second);
 }
 
-void EAGLE::feedCache(MaxCache &cache) {
-    // limiti
-    int maxi = ic->size() - 1;
-    int maxj = maxi + 1;
-
-    // numero di iterazioni e progresso
-    // unsigned long long int iters = maxi*maxj/2;
-    unsigned int leap = 1 + maxj / 200;
-    unsigned int iters = 0;
-
+void EAGLE::feedHeap(SimilarityHeap &heap) {
     // creazione array per omp
+    int maxj = ic->size();
     unsigned int *comms = new unsigned int[maxj];
     set<unsigned int>::const_iterator bi = ic->begin();
     set<unsigned int>::const_iterator ei = ic->end();
     unsigned int commc = 0;
     for (; bi != ei; bi++) comms[commc++] = *bi;
 
-    // array dei risultati
-    double *temp = new double[maxj];
-
-    // ciclo esterno, fissa la prima community (a)
-    for (int i = 0; i < maxi; i++) {
-        PROGRESS(iters, leap, '+')
-
-        unsigned int a = comms[i];
+    // risultati di ciascuna community, ogni coppia viene calcolata una volta
+    // sola dalla community con CID minore
+    vector<vector<pair<CID, double> > > temp(maxj);
+    unsigned int leap = 1 + maxj / 200;
 
-        // calcoliamo la similarity su più thread, ciclo interno
-#pragma omp parallel for default(none) shared(temp, comms, i, a, maxj)
-        for (int j = i + 1; j < maxj; j++)
-            temp[j] = ic->similarity(a, comms[j]);
+#pragma omp parallel for schedule(dynamic) default(none) shared(temp, comms, maxj)
+    for (int i = 0; i < maxj; i++)
+        ic->neighbourSimilarities(comms[i], temp[i], true);
 
-        // il master thread soltanto darà alla cache gli elementi generati
-        for (int j = i + 1; j < maxj; j++)
-            cache.check(a, comms[j], temp[j]);
+    // il master thread soltanto dà allo heap gli elementi generati
+    for (int i = 0; i < maxj; i++) {
+        PROGRESS(i, leap, '+')
 
-        // abbiamo fatto un'iterazione.
-        iters++;
+        heap.addCommunity(comms[i], ic->getComdegree(comms[i]));
+        for (unsigned int j = 0; j < temp[i].size(); j++)
+            heap.push(comms[i], temp[i][j].first, temp[i][j].second);
     }
 
-    // cancella gli array temporanei
     delete[] comms;
-    delete[] temp;
 }
 
 EAGLE::EAGLE(igraph_t *graph, int k, std::string prefix) {
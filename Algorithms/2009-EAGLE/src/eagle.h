@@ -5,7 +5,7 @@
 
 #include "communities.h"
 
-class MaxCache;
+class SimilarityHeap;
 
 class EAGLE {
 private:
@@ -17,9 +17,9 @@ private:
 
     Communities *ic;
 
-    void feedCache(MaxCache &cache);
+    void feedHeap(SimilarityHeap &heap);
 
-    void updateCache(MaxCache &cache, unsigned int c);
+    void updateHeap(SimilarityHeap &heap, unsigned int c);
 
     void getInitialCommunities();
 
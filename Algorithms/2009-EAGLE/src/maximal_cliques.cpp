@@ -0,0 +1,192 @@
+
+#include <algorithm>
+
+#include <omp.h>
+
+#include "maximal_cliques.h"
+
+using namespace std;
+
+typedef vector<unsigned int> NodeVector;
+
+/**
+ Calcola l'ordinamento per degenerazione, togliendo ogni volta un nodo di grado
+ minimo tra quelli rimasti (algoritmo dei k-core di Batagelj e Zaversnik).
+ */
+static void degeneracyOrder(const CSRGraph &graph, NodeVector &order) {
+    unsigned int n = graph.vcount();
+    NodeVector degree(n), position(n), bin;
+    unsigned int maxDegree = 0;
+
+    // i self loop non contano nelle clique
+    for (unsigned int v = 0; v < n; v++) {
+        degree[v] = graph.neighbourCount(v) - graph.areConnected(v, v);
+        maxDegree = max(maxDegree, degree[v]);
+    }
+
+    // bucket sort dei nodi per grado: bin[d] è l'inizio dei nodi di grado d
+    bin.assign(maxDegree + 1, 0);
+    for (unsigned int v = 0; v < n; v++) bin[degree[v]]++;
+    unsigned int start = 0;
+    for (unsigned int d = 0; d <= maxDegree; d++) {
+        unsigned int num = bin[d];
+        bin[d] = start;
+        start += num;
+    }
+
+    order.resize(n);
+    for (unsigned int v = 0; v < n; v++) {
+        position[v] = bin[degree[v]]++;
+        order[position[v]] = v;
+    }
+    for (unsigned int d = maxDegree; d > 0; d--) bin[d] = bin[d - 1];
+    bin[0] = 0;
+
+    // togliendo v, ai vicini di grado maggiore si abbassa il grado spostandoli
+    // all'inizio del loro bucket
+    for (unsigned int i = 0; i < n; i++) {
+        unsigned int v = order[i];
+
+        for (const unsigned int *u = graph.begin(v); u != graph.end(v); u++) {
+            if (degree[*u] <= degree[v]) continue;
+
+            unsigned int du = degree[*u], pu = position[*u];
+            unsigned int pw = bin[du], w = order[pw];
+            if (*u != w) {
+                position[*u] = pw;
+                order[pu] = w;
+                position[w] = pu;
+                order[pw] = *u;
+            }
+            bin[du]++;
+            degree[*u]--;
+        }
+    }
+}
+
+/// Scrive in out i nodi di set adiacenti a v (tranne v stesso)
+static void intersectNeighbours(const CSRGraph &graph, unsigned int v, const NodeVector &set, NodeVector &out) {
+    out.clear();
+    const unsigned int *w = graph.begin(v), *we = graph.end(v);
+    NodeVector::const_iterator s = set.begin(), se = set.end();
+
+    while (w != we && s != se) {
+        if (*w < *s) w++;
+        else if (*s < *w) s++;
+        else {
+            if (*s != v) out.push_back(*s);
+            w++;
+            s++;
+        }
+    }
+}
+
+/// Numero di nodi di set adiacenti a v
+static unsigned int countNeighbours(const CSRGraph &graph, unsigned int v, const NodeVector &set) {
+    unsigned int r = 0;
+    const unsigned int *w = graph.begin(v), *we = graph.end(v);
+    NodeVector::const_iterator s = set.begin(), se = set.end();
+
+    while (w != we && s != se) {
+        if (*w < *s) w++;
+        else if (*s < *w) s++;
+        else {
+            r += *s != v;
+            w++;
+            s++;
+        }
+    }
+
+    return r;
+}
+
+/**
+ Bron-Kerbosch con pivot: clique contiene R, candidates P ed excluded X, tutti
+ ordinati. Le clique massimali trovate vengono aggiunte in fondo a cliques.
+ */
+static void bronKerbosch(const CSRGraph &graph, unsigned int minSize, NodeVector &clique,
+                         NodeVector &candidates, NodeVector &excluded, vector<NodeVector> &cliques) {
+    if (candidates.empty()) {
+        if (excluded.empty() && clique.size() >= minSize) {
+            cliques.push_back(clique);
+            sort(cliques.back().begin(), cliques.back().end());
+        }
+        return;
+    }
+
+    // nessuna estensione può raggiungere minSize
+    if (clique.size() + candidates.size() < minSize) return;
+
+    // il pivot è il nodo di P o X con più vicini in P: i suoi vicini non vanno
+    // provati, perché ogni clique che li contiene viene trovata da un altro ramo
+    unsigned int pivot = candidates[0];
+    int best = -1;
+    for (int pass = 0; pass < 2; pass++) {
+        const NodeVector &set = pass ? excluded : candidates;
+        for (unsigned int i = 0; i < set.size(); i++) {
+            int c = countNeighbours(graph, set[i], candidates);
+            if (c > best) {
+                best = c;
+                pivot = set[i];
+            }
+        }
+    }
+
+    NodeVector branch;
+    intersectNeighbours(graph, pivot, candidates, branch);
+    NodeVector toVisit;
+    set_difference(candidates.begin(), candidates.end(), branch.begin(), branch.end(), back_inserter(toVisit));
+
+    NodeVector newCandidates, newExcluded;
+    for (unsigned int i = 0; i < toVisit.size(); i++) {
+        unsigned int v = toVisit[i];
+
+        intersectNeighbours(graph, v, candidates, newCandidates);
+        intersectNeighbours(graph, v, excluded, newExcluded);
+
+        clique.push_back(v);
+        bronKerbosch(graph, minSize, clique, newCandidates, newExcluded, cliques);
+        clique.pop_back();
+
+        // v passa da P a X
+        candidates.erase(lower_bound(candidates.begin(), candidates.end(), v));
+        excluded.insert(lower_bound(excluded.begin(), excluded.end(), v), v);
+    }
+}
+
+void maximalCliques(const CSRGraph &graph, unsigned int minSize, vector<NodeVector> &cliques) {
+    unsigned int n = graph.vcount();
+
+    NodeVector order;
+    degeneracyOrder(graph, order);
+
+    NodeVector position(n);
+    for (unsigned int i = 0; i < n; i++) position[order[i]] = i;
+
+    // le clique di ciascun nodo di partenza, da concatenare nell'ordine
+    vector<vector<NodeVector> > found(n);
+
+#pragma omp parallel for schedule(dynamic, 16) default(none) shared(graph, order, position, found, n, minSize)
+    for (int i = 0; i < (int) n; i++) {
+        unsigned int v = order[i];
+        NodeVector clique(1, v), candidates, excluded;
+
+        // i vicini che vengono dopo v sono i candidati, quelli che vengono
+        // prima sono già stati considerati; restano ordinati come nel CSR
+        for (const unsigned int *w = graph.begin(v); w != graph.end(v); w++) {
+            if (*w == v) continue;
+            if (position[*w] > (unsigned int) i) candidates.push_back(*w);
+            else excluded.push_back(*w);
+        }
+
+        bronKerbosch(graph, minSize, clique, candidates, excluded, found[i]);
+    }
+
+    for (unsigned int i = 0; i < n; i++) {
+        for (unsigned int j = 0; j < found[i].size(); j++) {
+            cliques.push_back(NodeVector());
+            cliques.back().swap(found[i][j]);
+        }
+        vector<NodeVector>().swap(found[i]);
+    }
+}
@@ -0,0 +1,27 @@
+
+#ifndef __MAXIMALCLIQUES_H
+#define __MAXIMALCLIQUES_H
+
+#include <vector>
+
+#include "csr_graph.h"
+
+/**
+ Trova tutte le clique massimali del grafo con almeno minSize nodi.
+
+ Usa Bron-Kerbosch con pivot sull'ordinamento per degenerazione (Eppstein,
+ Löffler, Strash): ogni clique viene trovata una sola volta, partendo dal suo
+ nodo che viene prima nell'ordinamento, e i candidati di ciascun nodo sono solo
+ i vicini che vengono dopo di lui, che non sono più della degenerazione del
+ grafo. Le posizioni dell'ordinamento vengono distribuite tra i thread di
+ OpenMP; il risultato non dipende dal numero di thread.
+
+ param graph Istantanea CSR del grafo.
+ param minSize Dimensione minima delle clique da restituire.
+ param cliques Vettore in cui vengono aggiunte le clique, ciascuna con i nodi
+ ordinati, nell'ordine dei rispettivi nodi di partenza.
+ */
+void maximalCliques(const CSRGraph &graph, unsigned int minSize,
+                    std::vector<std::vector<unsigned int> > &cliques);
+
+#endif // __MAXIMALCLIQUES_H
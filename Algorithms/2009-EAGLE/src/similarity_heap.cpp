@@ -0,0 +1,49 @@
+
+#include <cassert>
+
+#include "similarity_heap.h"
+
+using namespace std;
+
+SimilarityHeap::SimilarityHeap(double factor) {
+    this->factor = factor;
+}
+
+void SimilarityHeap::addCommunity(unsigned int c, unsigned int comdegree) {
+    if (c >= active.size()) active.resize(c + 1, false);
+    active[c] = true;
+    byDegree.insert(make_pair(comdegree, c));
+}
+
+void SimilarityHeap::removeCommunity(unsigned int c, unsigned int comdegree) {
+    active[c] = false;
+    byDegree.erase(make_pair(comdegree, c));
+}
+
+void SimilarityHeap::push(unsigned int i, unsigned int j, double s) {
+    Max m = {(int) i, (int) j, s};
+    heap.push(m);
+}
+
+unsigned int SimilarityHeap::size() const {
+    return byDegree.size();
+}
+
+void SimilarityHeap::discardInactive() {
+    while (!heap.empty() && !(active[heap.top().i] && active[heap.top().j])) heap.pop();
+}
+
+Max SimilarityHeap::top() {
+    assert(byDegree.size() > 1);
+    discardInactive();
+
+    // la migliore coppia lontana: le due community con comdegree minore
+    set<pair<unsigned int, unsigned int> >::const_iterator first = byDegree.begin();
+    set<pair<unsigned int, unsigned int> >::const_iterator second = first;
+    second++;
+    Max far = {(int) first->second, (int) second->second,
+               -factor * ((double) first->first * (double) second->first)};
+
+    if (heap.empty() || heap.top().s < far.s) return far;
+    return heap.top();
+}
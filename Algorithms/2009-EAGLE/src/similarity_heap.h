@@ -0,0 +1,95 @@
+
+#ifndef __SIMILARITYHEAP_H
+#define __SIMILARITYHEAP_H
+
+#include <queue>
+#include <set>
+#include <vector>
+#include <utility>
+
+/** Coppia di community candidata al merge
+ Un massimo è identificato da una coppia di indici, i e j, e da un valore s che
+ memorizza la similarity delle due community con indici i e j, appunto.
+
+ Il confronto si basa sul valore di s; a parità di s decidono gli indici, così
+ che l'ordine dei merge non dipenda dall'ordine di inserimento.
+ */
+struct Max {
+    /// Indice della prima community
+    int i;
+
+    /// Indice della seconda community
+    int j;
+
+    /// Similarity delle due community
+    double s;
+};
+
+/// Confronto LESS THAN per due elementi dello heap
+inline
+bool operator<(const Max &a, const Max &b) {
+    if (a.s != b.s) return a.s < b.s;
+    if (a.i != b.i) return a.i > b.i;
+    return a.j > b.j;
+}
+
+
+/** Heap incrementale delle similarity
+ La similarity tra due community dipende solo dalle due community, quindi una
+ volta calcolata resta valida finché nessuna delle due viene unita ad un'altra.
+ Nello heap vanno soltanto le coppie "vicine", cioè che condividono nodi o sono
+ collegate da almeno un edge: dopo un merge basta aggiungere le coppie della
+ nuova community. Le coppie che contengono una community non più attiva vengono
+ scartate quando arrivano in cima (cancellazione pigra).
+
+ Per una coppia lontana la similarity vale -factor * comdegree_a * comdegree_b,
+ ed è sempre minore o uguale a quella calcolata con la formula completa. La
+ migliore coppia lontana è quindi formata dalle due community attive con il
+ comdegree più piccolo, che vengono tenute ordinate in un set: se questa coppia
+ batte la cima dello heap non può essere vicina, e il suo valore è esatto.
+ */
+class SimilarityHeap {
+private:
+    /// Fattore di scala della similarity (lo stesso di Communities)
+    double factor;
+
+    /// Coppie vicine, eventualmente con community non più attive
+    std::priority_queue<Max> heap;
+
+    /// Community attive ordinate per comdegree
+    std::set<std::pair<unsigned int, unsigned int> > byDegree;
+
+    /// Indica per ogni CID se la community è attiva
+    std::vector<bool> active;
+
+    /// Toglie dalla cima dello heap le coppie non più valide
+    void discardInactive();
+
+public:
+    /**
+     Costruttore dello heap.
+
+     param factor Il fattore di scala usato nel calcolo della similarity.
+     */
+    SimilarityHeap(double factor);
+
+    /// Registra una community attiva con il suo comdegree
+    void addCommunity(unsigned int c, unsigned int comdegree);
+
+    /// Rimuove una community, le sue coppie verranno scartate
+    void removeCommunity(unsigned int c, unsigned int comdegree);
+
+    /// Inserisce una coppia vicina con la sua similarity
+    void push(unsigned int i, unsigned int j, double s);
+
+    /// Numero di community attive
+    unsigned int size() const;
+
+    /**
+     Restituisce la coppia di massima similarity tra le community attive, senza
+     toglierla. Richiede almeno due community attive.
+     */
+    Max top();
+};
+
+#endif // __SIMILARITYHEAP_H
@@ -0,0 +1,136 @@
+/*
+ Test di regressione dell'EQ incrementale.
+
+ Costruisce un piccolo grafo con clique sovrapposte, nodi subordinati ed edge
+ sparsi, e ripete il ciclo di merge di EAGLE::run fino a una sola community.
+ Dopo ogni merge l'EQ mantenuto da Communities::merge (EQ()) deve coincidere,
+ entro la tolleranza, con quello ricalcolato da zero (computeEQ()).
+
+ Restituisce 0 se tutti i controlli passano.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <boost/foreach.hpp>
+
+#include "../communities.h"
+#include "../maximal_cliques.h"
+#include "../similarity_heap.h"
+
+using namespace std;
+
+static int failures = 0;
+
+static void checkEQ(Communities &ic, const char *when, unsigned int step) {
+    double eq = ic.EQ();
+    double full = ic.computeEQ();
+    if (fabs(eq - full) > 1e-9 * (1.0 + fabs(full))) {
+        cerr.precision(17);
+        cerr << "FAILED: " << when << " " << step << ": EQ incrementale " << eq
+             << ", ricalcolato " << full << endl;
+        failures++;
+    }
+}
+
+// clique sovrapposte, perché i nodi con più membership sono il caso delicato
+// di loseMembership, più edge pseudo-casuali riproducibili tra i nodi
+static void buildGraph(igraph_t *graph) {
+    const unsigned int nodes = 60;
+    vector<vector<unsigned int> > cliques;
+    for (unsigned int start = 0; start + 5 <= 48; start += 3) {
+        vector<unsigned int> clique;
+        for (unsigned int v = start; v < start + 5; v++) clique.push_back(v);
+        cliques.push_back(clique);
+    }
+
+    vector<vector<bool> > adjacent(nodes, vector<bool>(nodes, false));
+    for (unsigned int c = 0; c < cliques.size(); c++)
+        for (unsigned int i = 0; i < cliques[c].size(); i++)
+            for (unsigned int j = i + 1; j < cliques[c].size(); j++)
+                adjacent[cliques[c][i]][cliques[c][j]] = true;
+
+    srand(7);
+    for (unsigned int e = 0; e < 80; e++) {
+        unsigned int a = rand() % nodes, b = rand() % nodes;
+        if (a == b) continue;
+        if (a > b) swap(a, b);
+        adjacent[a][b] = true;
+    }
+
+    vector<unsigned int> list;
+    for (unsigned int a = 0; a < nodes; a++)
+        for (unsigned int b = a + 1; b < nodes; b++)
+            if (adjacent[a][b]) {
+                list.push_back(a);
+                list.push_back(b);
+            }
+
+    igraph_vector_t edges;
+    igraph_vector_init(&edges, list.size());
+    for (unsigned int i = 0; i < list.size(); i++) VECTOR(edges)[i] = list[i];
+    igraph_create(graph, &edges, nodes, IGRAPH_UNDIRECTED);
+    igraph_vector_destroy(&edges);
+}
+
+int main() {
+    igraph_t graph;
+    buildGraph(&graph);
+
+    // come EAGLE::getInitialCommunities, con k = 3
+    Communities ic(&graph);
+    ic.prepareForEAGLE();
+
+    vector<vector<Node> > cliques;
+    maximalCliques(ic.getSnapshot(), 3, cliques);
+
+    unsigned int vs = igraph_vcount(&graph);
+    vector<bool> used(vs, false);
+    for (unsigned int i = 0; i < cliques.size(); i++) {
+        ic.addCommunity(new NodeSet(cliques[i].begin(), cliques[i].end()));
+        BOOST_FOREACH(Node node, cliques[i]) used[node] = true;
+    }
+    for (Node node = 0; node < vs; node++)
+        if (!used[node]) ic.addCommunity(node);
+
+    ic.precalculateData();
+    checkEQ(ic, "prima del merge", 0);
+
+    // come EAGLE::run, senza tenere la suddivisione migliore
+    SimilarityHeap heap(ic.getFactor());
+    vector<pair<CID, double> > neighbours;
+    for (set<CID>::const_iterator c = ic.begin(); c != ic.end(); c++) {
+        heap.addCommunity(*c, ic.getComdegree(*c));
+        ic.neighbourSimilarities(*c, neighbours, true);
+        for (unsigned int j = 0; j < neighbours.size(); j++)
+            heap.push(*c, neighbours[j].first, neighbours[j].second);
+    }
+
+    unsigned int merges = 0;
+    while (ic.size() > 1) {
+        Max merge = heap.top();
+        heap.removeCommunity(merge.i, ic.getComdegree(merge.i));
+        heap.removeCommunity(merge.j, ic.getComdegree(merge.j));
+
+        CID c = ic.merge(merge.i, merge.j, false);
+        merges++;
+        checkEQ(ic, "dopo il merge", merges);
+
+        heap.addCommunity(c, ic.getComdegree(c));
+        ic.neighbourSimilarities(c, neighbours);
+        for (unsigned int j = 0; j < neighbours.size(); j++)
+            heap.push(c, neighbours[j].first, neighbours[j].second);
+    }
+
+    ic.free();
+    igraph_destroy(&graph);
+
+    if (failures) {
+        cerr << failures << " controlli falliti su " << merges << " merge" << endl;
+        return EXIT_FAILURE;
+    }
+    cout << "EQ incrementale corretto dopo " << merges << " merge" << endl;
+    return EXIT_SUCCESS;
+}
@@ -7,7 +7,7 @@
 # 
 # compile using
 #module load intel-suite
-#icpc -mcmodel=large -i-dynamic -o linegraphcreator TseGraph.cpp main.cpp 
+#icpc -mcmodel=large -i-dynamic -o linegraphcreator TseGraph.cpp LineGraphView.cpp main.cpp 
 
 module load intel-suite
 export NAMEROOT=IC090729stempt
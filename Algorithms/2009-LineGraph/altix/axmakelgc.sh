@@ -1,2 +1,2 @@
 module load intel-suite
-icpc -xP -mcmodel=large -i-dynamic -o linegraphcreator TseGraph.cpp main.cpp
+icpc -xP -mcmodel=large -i-dynamic -o linegraphcreator TseGraph.cpp LineGraphView.cpp main.cpp
@@ -0,0 +1,185 @@
+/*
+ * File:   LineGraphView.cpp
+ * Line graph of a TseGraph which is never built in memory.
+ * See LineGraphView.h for more information.
+ */
+
+#include "LineGraphView.h"
+
+using namespace std;
+
+// same as in main.cpp, vertices of smaller strength give no line graph edges
+const double MINVIEWNORMALISATION=1e-10;
+
+// first bytes of a binary line graph file
+const char BINARYMAGIC[4] = {'T', 'L', 'G', 'B'};
+
+/**
+ * Creates a view of line graph type 0<=newType<=3 of tg.
+ * The view refers to tg which must not change while the view is used.
+ */
+LineGraphView::LineGraphView(TseGraph& g, int newType) : tg(g) {
+    if ((newType<0)||(newType>3)) {cout << "*** LineGraphView needs type to be between 0 and 3, was given " << newType << endl; exit(0);}
+    type = newType;
+    includeSelfLoops = ((type==1) || (type==3));
+    lgWeighted = ( tg.isWeighted() || (type>1) );
+    vertexStrength.resize(tg.getNumberVertices());
+    for (int v=0; v<tg.getNumberVertices(); v++) vertexStrength[v]=tg.getVertexStrength(v);
+}
+
+int
+LineGraphView::getNumberVertices(){return tg.getNumberStubs()/2;}
+
+bool
+LineGraphView::isWeighted(){return lgWeighted;}
+
+bool
+LineGraphView::isDirected(){return (tg.isDirected() || tg.isWeighted());}
+
+int
+LineGraphView::getType(){return type;}
+
+/**
+ * Normalisation of the edges from stub1 through vertex v=stubToVertex[stub1].
+ * Returns 0 if vertex v gives no line graph edges from this stub.
+ */
+double
+LineGraphView::getNormalisation(int v, int stub1){
+    int kv = tg.getVertexDegree(v);
+    if (kv <= (includeSelfLoops?0:1)) return 0;
+    if (!lgWeighted) return 1;
+    double norm = vertexStrength[v];
+    if (norm<MINVIEWNORMALISATION) return 0;
+    if (!includeSelfLoops) norm -= tg.getStubWeight(stub1);
+    return (norm<MINVIEWNORMALISATION?0:norm);
+}
+
+/**
+ * Weight of the line graph edge from stub1 to stub2 through vertex v.
+ * Both stubs must be stubs of vertex v.  Returns 0 if there is no edge.
+ */
+double
+LineGraphView::getWeight(int v, int stub1, int stub2){
+    if ((stub1==stub2) && !includeSelfLoops) return 0;
+    double norm = getNormalisation(v, stub1);
+    if (norm==0) return 0;
+    return (lgWeighted? tg.getStubWeight(stub2)/norm : 1);
+}
+
+/**
+ * Number of neighbours of line graph vertex e, counted once for each
+ * vertex where they meet.
+ */
+int
+LineGraphView::getVertexDegree(int e){
+    int k=0;
+    for (int stub1=2*e; stub1<=2*e+1; stub1++) {
+        int v = tg.stubToVertex[stub1];
+        if (getNormalisation(v, stub1)==0) continue;
+        k += tg.getVertexDegree(v) - (includeSelfLoops?0:1);
+    }
+    return k;
+}
+
+/**
+ * Generates the neighbours of line graph vertex e and the weights of the
+ * edges from e to them.  Previous contents of the vectors are removed.
+ */
+void
+LineGraphView::getNeighbours(int e, vector<int>& neighbours, vector<double>& weights){
+    neighbours.clear();
+    weights.clear();
+    for (int stub1=2*e; stub1<=2*e+1; stub1++) {
+        int v = tg.stubToVertex[stub1];
+        double norm = getNormalisation(v, stub1);
+        if (norm==0) continue;
+        for (int n = 0; n < tg.getVertexDegree(v); n++) {
+            int stub2 = tg.getStub(v, n);
+            if ((stub2==stub1) && !includeSelfLoops) continue;
+            neighbours.push_back(stub2>>1);
+            weights.push_back(lgWeighted? tg.getStubWeight(stub2)/norm : 1);
+        }
+    }
+}
+
+/**
+ * Number of line graph edges generated from each vertex, one for every
+ * pair of stubs of a vertex (including a stub paired with itself if
+ * self-loops are included).  This is the number of edges in the line graph
+ * when it has no multiple edges and is undirected.
+ */
+long
+LineGraphView::getNumberPairs(){
+    long pairs = 0;
+    for (int v = 0; v < tg.getNumberVertices(); v++) {
+        long kv = tg.getVertexDegree(v);
+        pairs += (includeSelfLoops? kv*(kv+1) : kv*(kv-1))/2;
+    }
+    return pairs;
+}
+
+/**
+ * Writes the line graph to a binary file, streaming it vertex by vertex
+ * of the original graph so the line graph is never held in memory.
+ *
+ * The file starts with the four characters TLGB then three 32-bit integers:
+ * the number of line graph vertices, the line graph type and the flags
+ * (1 if weighted, 2 if directed).  Then there is one record per line graph
+ * edge to the end of the file: 32-bit source and target vertices followed,
+ * if weighted, by the weight as a 64-bit double.  Undirected edges are
+ * written once, directed edges once in each direction.  Multiple edges are
+ * not merged, so weights of repeated pairs should be added when reading.
+ */
+void
+LineGraphView::writeBinary(char *outFile, bool infoOn){
+  FILE *fout = fopen(outFile, "wb");
+  if (fout==NULL) {
+  cerr << "Can't open output file " << outFile << endl;
+  exit(1);
+  }
+
+  int header[3];
+  header[0] = getNumberVertices();
+  header[1] = type;
+  header[2] = (lgWeighted?1:0) | (isDirected()?2:0);
+  fwrite(BINARYMAGIC, 1, sizeof(BINARYMAGIC), fout);
+  fwrite(header, sizeof(int), 3, fout);
+
+  const bool directed = isDirected();
+  long records=0;
+  int pair[2];
+  double w;
+  for (int v = 0; v < tg.getNumberVertices(); v++) {
+      int kv = tg.getVertexDegree(v);
+      for (int ni = 0; ni < kv; ni++) {
+          int stub1 = tg.getStub(v, ni);
+          for (int no = ni+(includeSelfLoops?0:1); no < kv; no++) {
+              int stub2 = tg.getStub(v, no);
+              w = getWeight(v, stub1, stub2);
+              if (w!=0) {
+                  pair[0]=stub1>>1;
+                  pair[1]=stub2>>1;
+                  fwrite(pair, sizeof(int), 2, fout);
+                  if (lgWeighted) fwrite(&w, sizeof(double), 1, fout);
+                  records++;
+              }
+              if (!directed || (stub1==stub2)) continue;
+              w = getWeight(v, stub2, stub1);
+              if (w!=0) {
+                  pair[0]=stub2>>1;
+                  pair[1]=stub1>>1;
+                  fwrite(pair, sizeof(int), 2, fout);
+                  if (lgWeighted) fwrite(&w, sizeof(double), 1, fout);
+                  records++;
+              }
+          }// eo for no
+      } //eo for ni
+  } //eo for v
+
+  if (ferror(fout)) {
+  cerr << "Error writing output file " << outFile << endl;
+  exit(1);
+  }
+  fclose(fout);
+  if (infoOn) cout << "Wrote " << records << " line graph edges to " << outFile << endl;
+}
@@ -0,0 +1,78 @@
+/*
+ * File:   LineGraphView.h
+ * Line graph of a TseGraph which is never built in memory.
+ * These line graphs are defined in the paper by T.S.Evans and R.Lambiotte,
+ * Line Graphs, Link Partitions and Overlapping Communities,
+ * Phys.Rev.E 80 (2009) 016105 [arXiv:0903.2181].
+ */
+
+#ifndef LINEGRAPHVIEW_H
+#define LINEGRAPHVIEW_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#include "TseGraph.h"
+
+using namespace std;
+
+/*
+ * Definitions.
+ *
+ * The vertices of the line graph are the edges e of the original graph, so
+ * there are (number stubs)/2 of them and line graph vertex e is made of the
+ * stubs (2e) and (2e+1).  Two line graph vertices are joined through every
+ * original vertex v where one of their stubs meets, so the neighbours of e are
+ * found on demand from vertexToStub of the two end vertices of e.  Nothing is
+ * stored apart from the strength of each original vertex.
+ *
+ * Line Graph Types (see makeLineGraph in main.cpp):-
+ * 0 Unweighted and no self loops (C of eqn 8)
+ * 1 Unweighted with self-loops (\tilde{C} of footnote 2)
+ * 2 Weighted and no self loops (D of eqn 11)
+ * 3 Weighted with self-loops (E of eqn 14)
+ *
+ * For the weighted types the contribution of vertex v to the line graph edge
+ * from stub1 to stub2 is w(stub2)/norm where norm is the strength of v,
+ * less w(stub1) if self-loops are excluded.  If the original graph is
+ * weighted these are not symmetric so the line graph is directed.
+ * If two line graph vertices meet at more than one vertex (multiple edges in
+ * the original graph) they are neighbours once for each vertex and the
+ * weights should be added.
+ */
+class LineGraphView {
+
+ public:
+
+LineGraphView(TseGraph& , int );
+
+int getNumberVertices();
+bool isWeighted();
+bool isDirected();
+int getType();
+
+int getVertexDegree(int);
+void getNeighbours(int , vector<int>& , vector<double>& );
+
+double getNormalisation(int , int );
+double getWeight(int , int , int );
+
+long getNumberPairs();
+void writeBinary(char *, bool);
+
+ private:
+
+TseGraph& tg;
+int type;
+bool includeSelfLoops;
+bool lgWeighted;
+
+// strength of each vertex of the original graph
+vector<double> vertexStrength;
+
+};
+
+#endif
@@ -1,3 +1,6 @@
+#ifndef TSEGRAPH_H
+#define TSEGRAPH_H
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <iostream>
@@ -105,3 +108,4 @@ bool directedGraph;
 
 };
 
+#endif
@@ -13,6 +13,7 @@
 #include <ostream>
 //#include <vector>
 #include "TseGraph.h"
+#include "LineGraphView.h"
 
 using namespace std;
 
@@ -22,6 +23,7 @@ char *infile = NULL;
 char *outfile = NULL;
 bool inGraphWeighted;
 bool infoOn=true;
+bool binaryOutput=false;
 int lgType=2;
 
 void 
@@ -67,6 +69,7 @@ usage(char *prog_name, char *more, ostream& os) {
   os << "usage: " << prog_name << " -i input_file -o output_file [options]" << endl << endl;
   os << "-t n\tcreate line graph of type 0<=n<=3. Default is 2." << endl;
   os << "-w\tread the graph as a weighted one. Otherwise graph is unweighted." << endl;
+  os << "-b\twrite the line graph in binary format, streamed without building it in memory." << endl;
   os << "-h\tshow this usage message." << endl;
   printLineGraphTypes(os);
   printFileFormats(os);
@@ -120,6 +123,9 @@ parse_args(int argc, char **argv) {
       case 'w' :
 	inGraphWeighted=true;
 	break;
+      case 'b' :
+	binaryOutput=true;
+	break;
       case 'h' :
 	usage(argv[0], "Options\n");
 	break;
@@ -290,6 +296,22 @@ int main(int argc, char **argv) {
        << endl;
 
   //if (lgType>-1) exit(0);
+
+  if (binaryOutput) {
+    // the line graph is generated from tg while it is written
+    time(&time_begin);
+    LineGraphView lgv(tg, lgType);
+    cout << "line graph: "
+         << lgv.getNumberVertices() << " vertices, "
+         << lgv.getNumberPairs() << " vertex pairs, "
+         << (lgv.isWeighted()?"weighted":"unweighted")
+         << endl;
+    lgv.writeBinary(outfile, infoOn);
+    time(&time_end);
+    display_time("finished making binary line graph file ");
+    cout <<  " time taken to write line graph to file "<< outfile << " " << (time_end-time_begin) << "s"  << endl;
+    return 0;
+  }
   
   // make line graph
   time(&time_begin);
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# Checks that the binary line graph written from LineGraphView (-b) has the
+# same edges, weights and direction as the line graph made by makeLineGraph.
+#
+# usage: python3 testLineGraphView.py [linegraphcreator]
+# Run from this directory, the default executable is ./linegraphcreator
+# compiled from TseGraph.cpp LineGraphView.cpp main.cpp.
+import os
+import struct
+import subprocess
+import sys
+
+executable = sys.argv[1] if len(sys.argv) > 1 else "./linegraphcreator"
+tempDir = "./"
+TOLERANCE = 1e-5
+
+
+def pairKey(source, target, directed):
+    if not directed and source > target:
+        return (target, source)
+    return (source, target)
+
+
+# weights of repeated pairs are added, as makeLineGraph does for weighted
+# line graphs, while unweighted ones keep a single edge of weight 1
+def addEdge(edges, source, target, weight, weighted, directed):
+    key = pairKey(source, target, directed)
+    edges[key] = (edges.get(key, 0.0) + weight) if weighted else 1.0
+
+
+def readText(fileName, weighted, directed):
+    edges = {}
+    for line in open(fileName, 'r'):
+        entries = line.split()
+        if len(entries) == 0:
+            continue
+        weight = float(entries[2]) if weighted else 1.0
+        addEdge(edges, int(entries[0]), int(entries[1]), weight, weighted, directed)
+    return edges
+
+
+# returns (flags, edges) with the weights of repeated pairs added,
+# flags is 1 if weighted plus 2 if directed
+def readBinary(fileName):
+    data = open(fileName, 'rb').read()
+    if data[:4] != b"TLGB":
+        raise ValueError(fileName + " is not a binary line graph file")
+    numberVertices, lgType, flags = struct.unpack_from("iii", data, 4)
+    weighted = (flags & 1) != 0
+    directed = (flags & 2) != 0
+    recordFormat = "iid" if weighted else "ii"
+    recordSize = struct.calcsize("=" + recordFormat)
+    edges = {}
+    for offset in range(16, len(data), recordSize):
+        record = struct.unpack_from("=" + recordFormat, data, offset)
+        weight = record[2] if weighted else 1.0
+        addEdge(edges, record[0], record[1], weight, weighted, directed)
+    return flags, edges
+
+
+def sameEdges(expected, found):
+    if set(expected.keys()) != set(found.keys()):
+        return False
+    for pair in expected:
+        if abs(expected[pair] - found[pair]) > TOLERANCE * max(1.0, abs(expected[pair])):
+            return False
+    return True
+
+
+def run(arguments):
+    with open(os.devnull, 'w') as devnull:
+        subprocess.check_call([executable] + arguments, stdout=devnull, stderr=devnull)
+
+
+failures = 0
+binaryFile = tempDir + "testLineGraphView.bin"
+textFile = tempDir + "testLineGraphView.dat"
+
+# unweighted input, the line graph made by makeLineGraph is undirected
+for lgType in range(4):
+    run(["-i", "input/BowTieinputEL.dat", "-o", textFile, "-t", str(lgType)])
+    run(["-i", "input/BowTieinputEL.dat", "-o", binaryFile, "-t", str(lgType), "-b"])
+    flags, found = readBinary(binaryFile)
+    expected = readText(textFile, lgType > 1, False)
+    ok = (flags == (1 if lgType > 1 else 0)) and sameEdges(expected, found)
+    print("BowTieinputEL.dat type " + str(lgType) + ": " + ("OK" if ok else "FAILED"))
+    failures += 0 if ok else 1
+
+# weighted input, the line graph is directed.  TseGraph can no longer hold a
+# directed graph so makeLineGraph stops here, and its output for this input is
+# the one kept in output/BowTieW_WLGoutputEL.dat
+run(["-i", "input/BowTieWinputEL.dat", "-o", binaryFile, "-t", "2", "-w", "-b"])
+flags, found = readBinary(binaryFile)
+expected = readText("output/BowTieW_WLGoutputEL.dat", True, True)
+ok = (flags == 3) and sameEdges(expected, found)
+print("BowTieWinputEL.dat type 2 weighted: " + ("OK" if ok else "FAILED"))
+failures += 0 if ok else 1
+
+for fileName in (binaryFile, textFile):
+    if os.path.exists(fileName):
+        os.remove(fileName)
+sys.exit(1 if failures else 0)
@@ -15,6 +15,11 @@ time_t t0 = clock();;
 //REPORTING
 #define REPORTING_OUTPUT_FREQUENCY 1000
 
+//PARALLEL EXPANSION
+//Number of seeds each thread expands ahead of the in-order commit. Larger batches balance better, but waste more
+//expansions on seeds that turn out to overlap one accepted earlier in the same batch.
+#define SPECULATIVE_SEEDS_PER_THREAD 16
+
 //PARAMETER STORAGE
 float community_finder::minimumOverlapToMerge;
 float community_finder::numberOfTimesRequiredToBeSpokenFor;
@@ -120,70 +125,104 @@ void community_finder::run() {
 
     bool issueAlphaWarning = false;
 
-    for (vector<Seed *>::iterator seedItr = this->seeds.begin(); seedItr != this->seeds.end(); ++seedItr) {
-        (*seedItr)->putIntoNodeToSeedsCache();
-
-        if (numberSeedsProcessed % REPORTING_OUTPUT_FREQUENCY == 0) {
-            fprintf(stderr, "%.2fs: ", (double) (clock() - t0) / CLOCKS_PER_SEC);
-            cerr << "Processed: " << numberSeedsProcessed << " seeds\n";
-
-            if (issueAlphaWarning) {
-                cerr << "Warning: size of growing communities exceeds probable size: try increasing Alpha value."
-                     << endl;
+    //With several threads, the seeds are expanded speculatively in batches, and then committed one by one in order.
+    //The commit phase does exactly what the single threaded loop does, using the expanded copy instead of expanding
+    //the seed itself, so the result does not depend on the number of threads.
+    int numberOfThreads = omp_get_max_threads();
+    bool speculative = numberOfThreads > 1;
+    int batchSize = speculative ? SPECULATIVE_SEEDS_PER_THREAD * numberOfThreads : 1;
+    int numberOfSeeds = this->seeds.size();
+
+    for (int batchStart = 0; batchStart < numberOfSeeds; batchStart += batchSize) {
+        int batchEnd = min(batchStart + batchSize, numberOfSeeds);
+        vector<Seed *> expandedSeeds(batchEnd - batchStart, (Seed *) NULL);
+
+        if (speculative) {
+#pragma omp parallel for schedule(dynamic)
+            for (int i = batchStart; i < batchEnd; i++) {
+                //Accepted seeds are never removed, so a seed that overlaps one of those accepted before this batch
+                //will be discarded before expansion in the commit phase too: don't expand it.
+                //The nodeToSeeds cache is only read here.
+                if (this->seeds[i]->overlapsAlreadyAcceptedSeed()) {
+                    continue;
+                }
+                Seed *expandedSeed = new Seed(*this->seeds[i]);
+                expandedSeed->expand();
+                expandedSeeds[i - batchStart] = expandedSeed;
             }
-            issueAlphaWarning = false;
         }
-        numberSeedsProcessed++;
 
-        bool alreadyCounted = false;
-        alreadyCounted = (*seedItr)->overlapsAlreadyAcceptedSeed();
+        for (int i = batchStart; i < batchEnd; i++) {
+            Seed *seed = this->seeds[i];
+            Seed *expandedSeed = expandedSeeds[i - batchStart];
+            seed->putIntoNodeToSeedsCache();
 
-        if (!alreadyCounted) {
+            if (numberSeedsProcessed % REPORTING_OUTPUT_FREQUENCY == 0) {
+                fprintf(stderr, "%.2fs: ", (double) (clock() - t0) / CLOCKS_PER_SEC);
+                cerr << "Processed: " << numberSeedsProcessed << " seeds\n";
 
-            (*seedItr)->updateCachedEdgeValuesFromScratch();
-            (*seedItr)->updateFrontierFromScratch();
-
-            //expand to first peak fitness, within threshold
-            while ((*seedItr)->addBestNodeFromFrontierToSeed() > 0) {
-            }
-
-            if ((*seedItr)->getNumberOfNodes() > (theGlobalGraph.vertex_count / 4)) {
-                if (!issueAlphaWarning) {
+                if (issueAlphaWarning) {
                     cerr << "Warning: size of growing communities exceeds probable size: try increasing Alpha value."
                          << endl;
-                    issueAlphaWarning = true;
                 }
+                issueAlphaWarning = false;
             }
+            numberSeedsProcessed++;
 
+            bool alreadyCounted = false;
+            alreadyCounted = seed->overlapsAlreadyAcceptedSeed();
 
-            alreadyCounted = (*seedItr)->overlapsAlreadyAcceptedSeed();
             if (!alreadyCounted) {
-                //	cerr << "Was not a duplicate\n";
-                //add it to results
-                numberSeedsKept++;
-                resultsVec.push_back((*seedItr));
+
+                //expand to first peak fitness, within threshold
+                if (expandedSeed != NULL) {
+                    *seed = *expandedSeed;
+                } else {
+                    seed->expand();
+                }
+                seed->putIntoNodeToSeedsCache();
+
+                if (seed->getNumberOfNodes() > (theGlobalGraph.vertex_count / 4)) {
+                    if (!issueAlphaWarning) {
+                        cerr << "Warning: size of growing communities exceeds probable size: try increasing Alpha value."
+                             << endl;
+                        issueAlphaWarning = true;
+                    }
+                }
+
+
+                alreadyCounted = seed->overlapsAlreadyAcceptedSeed();
+                if (!alreadyCounted) {
+                    //	cerr << "Was not a duplicate\n";
+                    //add it to results
+                    numberSeedsKept++;
+                    resultsVec.push_back(seed);
+                } else {
+                    //	cerr << "Was a duplicate\n";
+                    numberSeedsDiscardedAfterExpansion++;
+                }
+
             } else {
-                //	cerr << "Was a duplicate\n";
-                numberSeedsDiscardedAfterExpansion++;
+                numberSeedsDiscardedBeforeExpansion++;
             }
 
-            (*seedItr)->clearCaches();
-
-        } else {
-            numberSeedsDiscardedBeforeExpansion++;
-        }
+            if (alreadyCounted) {
+                seed->dead = true;
+                seed->removeFromNodeToSeedsList();
+            }
 
-        if (alreadyCounted) {
-            (*seedItr)->dead = true;
-            (*seedItr)->removeFromNodeToSeedsList();
+            delete expandedSeed;
         }
-
     }
 
     fprintf(stderr, "%.2fs: ", (double) (clock() - t0) / CLOCKS_PER_SEC);
     cerr << "Number seeds discarded before expansion: " << numberSeedsDiscardedBeforeExpansion << " seeds\n";
     cerr << "Number seeds discarded after expansion: " << numberSeedsDiscardedAfterExpansion << " seeds\n";
     cerr << "Number seeds kept: " << numberSeedsKept << " seeds\n";
+#ifdef OVERLAP_EXHAUSTIVE_CHECK
+    cerr << "Overlap checks where the counting and exhaustive checks disagreed: "
+         << Seed::exhaustiveOverlapDisagreements << "\n";
+#endif
 
     this->sweepTheDead();
     //TODO make this more efficient in future.
@@ -215,7 +254,7 @@ void community_finder::doSpokenForPruning() {
 
 
         int numberOfNodesAlreadySpokenFor = 0;
-        for (set<V>::iterator nodeItr = (*seedItr)->getNodes().begin();
+        for (vector<V>::const_iterator nodeItr = (*seedItr)->getNodes().begin();
              nodeItr != (*seedItr)->getNodes().end(); ++nodeItr) {
             int numberOfTimesRequiredToBeSpokenFor = community_finder::numberOfTimesRequiredToBeSpokenFor;
             if (spokenForTimes[(*nodeItr)] > numberOfTimesRequiredToBeSpokenFor) {
@@ -235,7 +274,7 @@ void community_finder::doSpokenForPruning() {
         } else {
             //this clique is good
             //so tag its nodes as taken.
-            for (set<V>::iterator nodeItr = (*seedItr)->getNodes().begin();
+            for (vector<V>::const_iterator nodeItr = (*seedItr)->getNodes().begin();
                  nodeItr != (*seedItr)->getNodes().end(); ++nodeItr) {
                 spokenForTimes[(*nodeItr)]++;
             }
@@ -9,6 +9,7 @@
 #define COMMUNITY_FINDER_H_
 
 #include <time.h>
+#include <omp.h>
 
 #include <iostream>
 #include <map>
@@ -24,7 +25,7 @@ using namespace std;
 //global graph
 extern SimpleIntGraph theGlobalGraph;
 
-extern vector<set<Seed *> > nodeToSeeds;
+extern NodeToSeedsIndex nodeToSeeds;
 
 class community_finder {
 
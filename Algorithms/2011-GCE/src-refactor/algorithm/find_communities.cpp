@@ -12,7 +12,7 @@ using namespace std;
 //global graph
 SimpleIntGraph theGlobalGraph;
 //This vector is a map of each node to the set of seeds that are in it.
-vector<set<Seed *> > nodeToSeeds;
+NodeToSeedsIndex nodeToSeeds;
 
 int main(int argc, char **argv) {
     cerr << "Greedy Clique Expansion Community Finder" << endl;
@@ -83,10 +83,10 @@ int main(int argc, char **argv) {
 /*
 // print node->seed assignments
 	int count = 0;
-	for( vector< set<Seed*> >::iterator nodeToSeedsItr = nodeToSeeds.begin(); nodeToSeedsItr != nodeToSeeds.end(); ++nodeToSeedsItr)
+	for( NodeToSeedsIndex::iterator nodeToSeedsItr = nodeToSeeds.begin(); nodeToSeedsItr != nodeToSeeds.end(); ++nodeToSeedsItr)
 	{
 		cout << "Node " << count++ << " : ";
-		for( set<Seed*> ::iterator innerItr = (*nodeToSeedsItr).begin(); innerItr != (*nodeToSeedsItr).end(); ++innerItr)
+		for( SeedList::const_iterator innerItr = (*nodeToSeedsItr).begin(); innerItr != (*nodeToSeedsItr).end(); ++innerItr)
 		{
 			 (*innerItr)->prettyPrint();
 
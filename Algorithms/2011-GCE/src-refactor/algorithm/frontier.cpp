@@ -0,0 +1,54 @@
+/*
+ * Frontier.cpp
+ *
+ * See Frontier.h.
+ */
+
+#include "frontier.h"
+
+bool Frontier::contains(V theNode) const {
+    return this->nodeToInternalAndExternalEdges.find(theNode) != this->nodeToInternalAndExternalEdges.end();
+}
+
+pair<int, int> Frontier::getEdges(V theNode) const {
+    return this->nodeToInternalAndExternalEdges.at(theNode);
+}
+
+void Frontier::setEdges(V theNode, pair<int, int> internalAndExternalEdges) {
+    pair<unordered_map<V, pair<int, int> >::iterator, bool> inserted =
+            this->nodeToInternalAndExternalEdges.insert(make_pair(theNode, internalAndExternalEdges));
+    if (!inserted.second) {
+        //already on the frontier, take it out of its old group first
+        pair<int, int> &oldEdges = (*inserted.first).second;
+        if (oldEdges == internalAndExternalEdges) {
+            return;
+        }
+        this->erase(theNode);
+        this->nodeToInternalAndExternalEdges[theNode] = internalAndExternalEdges;
+    }
+    this->internalEdgesToNodes[internalAndExternalEdges.first].insert(
+            make_pair(internalAndExternalEdges.second, theNode));
+}
+
+void Frontier::erase(V theNode) {
+    unordered_map<V, pair<int, int> >::iterator nodeItr = this->nodeToInternalAndExternalEdges.find(theNode);
+    if (nodeItr == this->nodeToInternalAndExternalEdges.end()) {
+        return;
+    }
+
+    map<int, set<pair<int, V> > >::iterator groupItr = this->internalEdgesToNodes.find((*nodeItr).second.first);
+    (*groupItr).second.erase(make_pair((*nodeItr).second.second, theNode));
+    if ((*groupItr).second.empty()) {
+        this->internalEdgesToNodes.erase(groupItr);
+    }
+    this->nodeToInternalAndExternalEdges.erase(nodeItr);
+}
+
+void Frontier::clear() {
+    this->nodeToInternalAndExternalEdges.clear();
+    this->internalEdgesToNodes.clear();
+}
+
+int Frontier::size() const {
+    return this->nodeToInternalAndExternalEdges.size();
+}
@@ -0,0 +1,89 @@
+/*
+ * Frontier.h
+ *
+ * The frontier of a seed: the nodes outside the seed that have at least one
+ * edge into it, with their cached number of internal and external edges.
+ */
+
+#ifndef FRONTIER_H_
+#define FRONTIER_H_
+
+#include <set>
+#include <map>
+#include <unordered_map>
+
+#include "../util/graph/graph_representation.hpp"
+
+using namespace std;
+
+//The fitness if a frontier node is inserted depends on the internal and external edges of the whole seed,
+//so every node's value changes whenever the seed grows and a heap of fitnesses would need a full rebuild.
+//Instead, the frontier nodes are indexed by their internal edges, and for each internal edge count they are kept
+//ordered by (external edges, node). For a fixed number of internal edges the fitness only falls as the external
+//edges grow, so each group's first nodes are the only candidates: finding the best node costs one fitness
+//evaluation per distinct internal edge count, and inserting a node into the seed only moves its neighbours.
+class Frontier {
+public:
+    bool contains(V theNode) const;
+
+    //returns the cached (internal, external) edges of a node on the frontier
+    pair<int, int> getEdges(V theNode) const;
+
+    //adds the node, or replaces its cached edges if it is already on the frontier
+    void setEdges(V theNode, pair<int, int> internalAndExternalEdges);
+
+    void erase(V theNode);
+
+    void clear();
+
+    int size() const;
+
+    //Finds the node whose insertion gives the highest fitness, if that is strictly above currentFitness.
+    //Ties are won by the lowest node, as when scanning the nodes in order. Returns -1 if no node qualifies.
+    //fitness(internal, external) must not increase with the external edges.
+    template<class FitnessFunction>
+    V bestNode(FitnessFunction fitness, float currentFitness, float &bestFitness) const;
+
+private:
+    unordered_map<V, pair<int, int> > nodeToInternalAndExternalEdges;
+    map<int, set<pair<int, V> > > internalEdgesToNodes;
+};
+
+template<class FitnessFunction>
+V Frontier::bestNode(FitnessFunction fitness, float currentFitness, float &bestFitness) const {
+    V bestNode = -1;
+    bestFitness = currentFitness;
+
+    for (map<int, set<pair<int, V> > >::const_iterator groupItr = this->internalEdgesToNodes.begin();
+         groupItr != this->internalEdgesToNodes.end(); ++groupItr) {
+        int internalEdges = (*groupItr).first;
+        const set<pair<int, V> > &group = (*groupItr).second;
+
+        //the first node of the group has the fewest external edges, so the highest fitness in the group.
+        //Nodes with more external edges can only tie with it, so walk on while the fitness is unchanged.
+        set<pair<int, V> >::const_iterator nodeItr = group.begin();
+        float groupFitness = fitness(internalEdges, (*nodeItr).first);
+        if (!(groupFitness > bestFitness || (groupFitness == bestFitness && bestNode != -1))) {
+            continue;
+        }
+
+        V groupBest = (*nodeItr).second;
+        while (true) {
+            //skip the remaining nodes with the same external edges, they all come after this one
+            nodeItr = group.lower_bound(make_pair((*nodeItr).first + 1, (V) -1));
+            if (nodeItr == group.end() || fitness(internalEdges, (*nodeItr).first) != groupFitness) {
+                break;
+            }
+            groupBest = min(groupBest, (*nodeItr).second);
+        }
+
+        if (groupFitness > bestFitness || groupBest < bestNode) {
+            bestNode = groupBest;
+            bestFitness = groupFitness;
+        }
+    }
+
+    return bestNode;
+}
+
+#endif /* FRONTIER_H_ */
@@ -0,0 +1,47 @@
+/*
+ * NodeToSeeds.cpp
+ *
+ * See NodeToSeeds.h.
+ */
+
+#include <algorithm>
+
+#include "node_to_seeds.h"
+
+void SeedList::emplace(Seed *seed) {
+    uintptr_t entry = (uintptr_t) seed;
+    //a tombstone of this seed sorts right after it, so lower_bound finds either
+    vector<uintptr_t>::iterator position = lower_bound(this->entries.begin(), this->entries.end(), entry);
+    if (position != this->entries.end() && (*position & ~(uintptr_t) 1) == entry) {
+        if (*position & 1) {
+            //revive the tombstone
+            *position = entry;
+            this->tombstones--;
+        }
+        return;
+    }
+    this->entries.insert(position, entry);
+}
+
+void SeedList::erase(Seed *seed) {
+    uintptr_t entry = (uintptr_t) seed;
+    vector<uintptr_t>::iterator position = lower_bound(this->entries.begin(), this->entries.end(), entry);
+    if (position == this->entries.end() || *position != entry) {
+        return;
+    }
+    *position |= 1;
+    this->tombstones++;
+    if (2 * this->tombstones >= this->entries.size()) {
+        this->compact();
+    }
+}
+
+void SeedList::compact() {
+    vector<uintptr_t>::iterator newEnd = remove_if(this->entries.begin(), this->entries.end(),
+                                                   [](uintptr_t entry) { return (entry & 1) != 0; });
+    this->entries.erase(newEnd, this->entries.end());
+    this->tombstones = 0;
+    if (this->entries.capacity() > 2 * this->entries.size()) {
+        this->entries.shrink_to_fit();
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * NodeToSeeds.h
+ *
+ * The inverted index from each node to the seeds containing it.
+ */
+
+#ifndef NODE_TO_SEEDS_H_
+#define NODE_TO_SEEDS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+#include <iterator>
+
+#include "../util/graph/graph_representation.hpp"
+
+using namespace std;
+
+class Seed;
+
+//The seeds containing one node, as a vector sorted by address, so it iterates in the same order as a set<Seed *>.
+//Erasing only marks the entry with a tombstone (the lowest bit of the pointer, which Seed's alignment leaves free,
+//so the vector stays sorted), and the list is compacted once the tombstones are at least half of it.
+//A set would cost a tree node per entry; here an entry is a single pointer.
+class SeedList {
+public:
+    //Iterates over the live seeds, skipping the tombstones.
+    class const_iterator {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef Seed *value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Seed *const *pointer;
+        typedef Seed *reference;
+
+        const_iterator(const uintptr_t *position, const uintptr_t *end) : position(position), end(end) {
+            this->skipTombstones();
+        }
+
+        Seed *operator*() const {
+            return (Seed *) *this->position;
+        }
+
+        const_iterator &operator++() {
+            ++this->position;
+            this->skipTombstones();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator &other) const {
+            return this->position == other.position;
+        }
+
+        bool operator!=(const const_iterator &other) const {
+            return this->position != other.position;
+        }
+
+    private:
+        void skipTombstones() {
+            while (this->position != this->end && (*this->position & 1)) {
+                ++this->position;
+            }
+        }
+
+        const uintptr_t *position;
+        const uintptr_t *end;
+    };
+
+    SeedList() : tombstones(0) {
+    }
+
+    const_iterator begin() const {
+        const uintptr_t *data = this->entries.data();
+        return const_iterator(data, data + this->entries.size());
+    }
+
+    const_iterator end() const {
+        const uintptr_t *data = this->entries.data();
+        return const_iterator(data + this->entries.size(), data + this->entries.size());
+    }
+
+    //adds the seed if it is not already in the list
+    void emplace(Seed *seed);
+
+    void erase(Seed *seed);
+
+    //number of live seeds
+    size_t size() const {
+        return this->entries.size() - this->tombstones;
+    }
+
+    bool empty() const {
+        return this->size() == 0;
+    }
+
+private:
+    void compact();
+
+    vector<uintptr_t> entries;
+    unsigned int tombstones;
+};
+
+//One SeedList per node.
+class NodeToSeedsIndex {
+public:
+    typedef vector<SeedList>::iterator iterator;
+    typedef vector<SeedList>::const_iterator const_iterator;
+
+    SeedList &operator[](V node) {
+        return this->lists[node];
+    }
+
+    const SeedList &operator[](V node) const {
+        return this->lists[node];
+    }
+
+    iterator begin() {
+        return this->lists.begin();
+    }
+
+    iterator end() {
+        return this->lists.end();
+    }
+
+    const_iterator begin() const {
+        return this->lists.begin();
+    }
+
+    const_iterator end() const {
+        return this->lists.end();
+    }
+
+    size_t size() const {
+        return this->lists.size();
+    }
+
+    void resize(size_t numberOfNodes) {
+        this->lists.resize(numberOfNodes);
+    }
+
+    void clear() {
+        this->lists.clear();
+    }
+
+private:
+    vector<SeedList> lists;
+};
+
+#endif /* NODE_TO_SEEDS_H_ */
@@ -22,7 +22,7 @@ Seed::~Seed() {
 
 
 void Seed::removeFromNodeToSeedsList() {
-    for (set<V>::iterator nodeItr = this->nodes.begin(); nodeItr != this->nodes.end(); ++nodeItr) {
+    for (vector<V>::iterator nodeItr = this->nodes.begin(); nodeItr != this->nodes.end(); ++nodeItr) {
         //for each of the nodes
         (nodeToSeeds[(*nodeItr)]).erase(this);
     }
@@ -36,16 +36,60 @@ float Seed::alphaValueForFitness;
 /////////
 
 bool Seed::isEqualTo(Seed &other) {
-    set<V> result;
+    vector<V> result;
     set_difference((this)->nodes.begin(), (this)->nodes.end(), (other).nodes.begin(), (other).nodes.end(),
-                   inserter(result, result.begin()));
+                   back_inserter(result));
     return (result.size() == 0);
 }
 
 
+long Seed::exhaustiveOverlapDisagreements = 0;
+
 //returns true if this seed overlaps ANY seed that has already been accepted
-//makes use of the node->seeds map, for speed.
 bool Seed::overlapsAlreadyAcceptedSeed() {
+    bool overlaps = this->overlapsAlreadyAcceptedSeedCounting();
+#ifdef OVERLAP_EXHAUSTIVE_CHECK
+    bool overlapsExhaustive = this->overlapsAlreadyAcceptedSeedExhaustive();
+    if (overlaps != overlapsExhaustive) {
+#pragma omp atomic
+        Seed::exhaustiveOverlapDisagreements++;
+    }
+    return overlapsExhaustive;
+#else
+    return overlaps;
+#endif
+}
+
+//Counts the nodes shared with every seed in one walk of the node->seeds lists of this seed's nodes: a seed appears
+//once in the list of each node it shares, so after sorting, the length of its run is the size of the intersection.
+bool Seed::overlapsAlreadyAcceptedSeedCounting() {
+    static thread_local vector<Seed *> sharing;
+    sharing.clear();
+    for (vector<V>::iterator nodeItr = this->nodes.begin(); nodeItr != this->nodes.end(); ++nodeItr) {
+        const SeedList &seedsOfNode = nodeToSeeds[(*nodeItr)];
+        sharing.insert(sharing.end(), seedsOfNode.begin(), seedsOfNode.end());
+    }
+    sort(sharing.begin(), sharing.end());
+
+    for (vector<Seed *>::iterator runStart = sharing.begin(); runStart != sharing.end();) {
+        vector<Seed *>::iterator runEnd = upper_bound(runStart, sharing.end(), *runStart);
+        Seed *other = *runStart;
+        if ((other != this) && !other->dead) {
+            //the same value Seed::overlap computes
+            size_t shared = runEnd - runStart;
+            if (float(shared) / min(other->getNodes().size(), this->getNodes().size()) >=
+                Seed::minimumOverlapToMerge) {
+                return true;
+            }
+        }
+        runStart = runEnd;
+    }
+    return false;
+}
+
+//Checks every seed that shares a node with this one, intersecting their nodes.
+//makes use of the node->seeds map, for speed.
+bool Seed::overlapsAlreadyAcceptedSeedExhaustive() {
     //get the union of the set of cliques that each node is in
 
 
@@ -53,7 +97,7 @@ bool Seed::overlapsAlreadyAcceptedSeed() {
     set<Seed *> oldResult;
     //for each of the nodes
 
-    for (set<V>::iterator nodeItr = this->nodes.begin(); nodeItr != this->nodes.end(); ++nodeItr) {
+    for (vector<V>::iterator nodeItr = this->nodes.begin(); nodeItr != this->nodes.end(); ++nodeItr) {
 
         result.clear();
         //this could be faster if it returned a pointer to a set of seed*, rather than a set of seed*
@@ -91,9 +135,9 @@ float Seed::overlap(Seed &other) {
     //{
     //	cerr << "Number of overlap checks done so far: " << numberOfOverlapChecks << endl;
     //}
-    set<V> result;
+    vector<V> result;
     set_intersection(this->nodes.begin(), this->nodes.end(), other.nodes.begin(), other.nodes.end(),
-                     inserter(result, result.begin()));
+                     back_inserter(result));
     return float(result.size()) / min(other.getNodes().size(), this->getNodes().size());
 }
 
@@ -109,73 +153,62 @@ float Seed::overlap(Seed &other) {
 //Requires the new node to increase the fitness.
 float Seed::addBestNodeFromFrontierToSeed() {
     //search across the possible fitnesses of the frontier.
-    //cerr << "In addBestNodeFromFrontierToSeed for seed: ";
-    //this->prettyPrint();
-    float highestFitness = this->calculateFitness();
-    //float highestFitness = -1;
-    V bestNode = -1;
-
-    for (map<V, pair<int, int> >::iterator frontierNodeToInternalAndExternalEdgesItr = this->frontierNodeToInternalAndExternalEdges.begin();
-         frontierNodeToInternalAndExternalEdgesItr !=
-         this->frontierNodeToInternalAndExternalEdges.end(); ++frontierNodeToInternalAndExternalEdgesItr)
-        //for( set < V >::iterator frontierItr= this->frontier.begin(); frontierItr != this->frontier.end(); ++frontierItr)
-    {
-        //	cerr << "Considering next frontier node...\n";
-        //	this->prettyPrintFrontier();
-        //	cerr << (*frontierItr);
-        //if ((*frontierItr).second > highestFitness)
-
-
-        //This is the main optimisation, right here, where, instead of iterating across (the current Seed Union theNewNode) and calculating each nodes internal and external degree by traversing the nodes edges, and seeing if they are inside or outside the seed - instead we use the cached values of the number of edges that are inside and outside the seed, for each node on the frontier.  This cache can later by updated, as it only changes for those frontier nodes which are connected to the node added to the seed.
-        float tempFitness = this->calculateFitnessIfInsertFromFrontier(
-                (*frontierNodeToInternalAndExternalEdgesItr).second.first,
-                (*frontierNodeToInternalAndExternalEdgesItr).second.second);
-        //	cerr << " with cached fitness: " << tempFitness;
-        if (tempFitness > highestFitness) {
-            //		cerr << "...higher than existing highest fitness" << highestFitness << " \n";
-            bestNode = ((*frontierNodeToInternalAndExternalEdgesItr).first);
-            highestFitness = tempFitness;
-        } else {
-            //		cerr << "...NOT higher than existing highest fitness" << highestFitness << " \n";
+    float highestFitness;
 
-        }
+    //This is the main optimisation, right here, where, instead of iterating across (the current Seed Union theNewNode) and calculating each nodes internal and external degree by traversing the nodes edges, and seeing if they are inside or outside the seed - instead we use the cached values of the number of edges that are inside and outside the seed, for each node on the frontier.  This cache can later by updated, as it only changes for those frontier nodes which are connected to the node added to the seed.
+    //The frontier only evaluates the fitness of its best node for each number of internal edges.
+    V bestNode = this->frontier.bestNode(
+            [this](int internalEdgesOfNode, int externalEdgesOfNode) {
+                return this->calculateFitnessIfInsertFromFrontier(internalEdgesOfNode, externalEdgesOfNode);
+            },
+            this->calculateFitness(), highestFitness);
 
-    }
     if (bestNode > -1) {
-        //	cerr << "So, adding node: " << bestNode << " to seed\n";
         //Found a node with a better fitness than the threshold.
         this->addNodeFromFrontier(bestNode);
-
-        //DEBUG
-        //	this->rawPrint();
-        //	this->prettyPrintFrontier();
-        //	cerr << "Fitness now, recaclulated: " << this->calculateFitness();
-
         return highestFitness;
     } else {
-        //	cerr << "No best node found\n";
         return -1;
     }
 }
 
 
+//Greedily adds the best frontier node while that increases the fitness.
+//The nodes are not put into the nodeToSeeds cache, and nothing outside this seed is changed.
+void Seed::expand() {
+    this->updateCachedEdgeValuesFromScratch();
+    this->updateFrontierFromScratch();
+
+    while (this->addBestNodeFromFrontierToSeed() > 0) {
+    }
+
+    this->clearCaches();
+}
+
+
 //Can add a node from anywhere.
 //This dirties the caches.
 void Seed::addNode(V newNode) {
     this->nodesInOrderOfAddition.push_back(newNode);
-    this->nodes.insert(newNode);
+    vector<V>::iterator position = lower_bound(this->nodes.begin(), this->nodes.end(), newNode);
+    if (position == this->nodes.end() || *position != newNode) {
+        this->nodes.insert(position, newNode);
+    }
     (nodeToSeeds[newNode]).emplace(this);
 }
 
 
 void Seed::addNodeNoCaching(V newNode) {
     this->nodesInOrderOfAddition.push_back(newNode);
-    this->nodes.insert(newNode);
+    vector<V>::iterator position = lower_bound(this->nodes.begin(), this->nodes.end(), newNode);
+    if (position == this->nodes.end() || *position != newNode) {
+        this->nodes.insert(position, newNode);
+    }
 }
 
 //put all of this seeds nodes into the NodeToSeeds Cache
 void Seed::putIntoNodeToSeedsCache() {
-    for (set<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
+    for (vector<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
         (nodeToSeeds[(*innerSeedItr)]).emplace(this);
     }
 }
@@ -211,8 +244,8 @@ void Seed::addNodeFromFrontier(V newNode) {
     //This if statement existed as an assertion to catch coding errors; disable for performance now that the implementation is stable.
     //if (this->frontierContains(newNode))
     //{
-    pair<int, int> newValuesIfInsert = this->frontierNodeToInternalAndExternalEdges[newNode];
-    this->frontierNodeToInternalAndExternalEdges.erase(newNode);
+    pair<int, int> newValuesIfInsert = this->frontier.getEdges(newNode);
+    this->frontier.erase(newNode);
     //this->frontier.erase(newNode);
 
     //	cerr << "\n Cached node internal edges: " << newValuesIfInsert.first;
@@ -228,7 +261,7 @@ void Seed::addNodeFromFrontier(V newNode) {
 
 
     //bool temp = this->cachesDirty;
-    this->addNode(newNode);
+    this->addNodeNoCaching(newNode);
     //this->cachesDirty = temp;
 
     //Now just need to update the frontier.
@@ -258,13 +291,12 @@ void Seed::addNodeFromFrontier(V newNode) {
             //			cerr << " was NOT in seed. ";
             if (this->frontierContains(otherNode)) {
                 //				cerr << " but was in frontier ";
-                pair<int, int> oldValuesCached = this->frontierNodeToInternalAndExternalEdges[otherNode];
+                pair<int, int> oldValuesCached = this->frontier.getEdges(otherNode);
                 //				cerr << " and had internal: " << oldValuesCached.first << " and external: " << oldValuesCached.second << " ";
                 oldValuesCached.first = oldValuesCached.first + 1;
                 oldValuesCached.second = oldValuesCached.second - 1;
 
-                //this->frontier.insert(otherNode);
-                this->frontierNodeToInternalAndExternalEdges[otherNode] = oldValuesCached;
+                this->frontier.setEdges(otherNode, oldValuesCached);
                 //				cerr << " updated from caches with internal: " << oldValuesCached.first << " and external: " << oldValuesCached.second << " ";
 
             } else {
@@ -274,8 +306,7 @@ void Seed::addNodeFromFrontier(V newNode) {
                 //We do that here; its not a cheap operation but it is necessary even in the non-caching solution, and its much cheaper overall than not using a cache.
                 pair<int, int> otherTempPair = this->calculateNumberOfInternalAndExternalEdgesForNodeFromScratch(
                         otherNode);
-                //this->frontier.insert(otherNode);
-                this->frontierNodeToInternalAndExternalEdges[otherNode] = otherTempPair;
+                this->frontier.setEdges(otherNode, otherTempPair);
                 //				cerr << " updated from scratch with internal: " << otherTempPair.first << " and external: " << otherTempPair.second << " ";
             }
 
@@ -294,16 +325,15 @@ void Seed::addNodeFromFrontier(V newNode) {
 
 
 //This function updates the frontier, requiring no other information.
-//It updates the frontierNodeToInternalAndExternalEdges array
+//It updates the frontier and its cached internal and external edges
 //Takes the current seed, and completely updates its frontier.
 void Seed::updateFrontierFromScratch() {
     //cerr << "Updating frontier from scratch for seed: " << endl;
     //this->prettyPrint();
 
-    this->frontierNodeToInternalAndExternalEdges.clear();
-    //this->frontier.clear();
+    this->frontier.clear();
 
-    for (set<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
+    for (vector<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
         V currentNode = (*innerSeedItr);
         pair<V *, V *> startAndEnd = theGlobalGraph.neighbours(currentNode);
 
@@ -319,8 +349,7 @@ void Seed::updateFrontierFromScratch() {
             } else {
                 pair<int, int> otherTempPair = this->calculateNumberOfInternalAndExternalEdgesForNodeFromScratch(
                         otherNode);
-                //this->frontier.insert(otherNode);
-                this->frontierNodeToInternalAndExternalEdges[otherNode] = otherTempPair;
+                this->frontier.setEdges(otherNode, otherTempPair);
                 //			cerr << "Got internal edges: " << otherTempPair.first;
                 //			cerr << " and external edges: " << otherTempPair.second;
                 //			cerr << " for frontier node: " << otherNode << endl;
@@ -341,7 +370,7 @@ void Seed::updateCachedEdgeValuesFromScratch() {
     int countInternals = 0;
     int countExternals = 0;
 
-    for (set<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
+    for (vector<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
         V currentNode = (*innerSeedItr);
         //For each of the edge points of current node, is it inside or outside the seed?
 
@@ -368,8 +397,7 @@ void Seed::updateCachedEdgeValuesFromScratch() {
 }
 
 void Seed::clearCaches() {
-    //this->frontier.clear();
-    this->frontierNodeToInternalAndExternalEdges.clear();
+    this->frontier.clear();
 
 }
 
@@ -442,7 +470,7 @@ inline int Seed::getExternalEdges() {
 }
 
 
-const set<V> &Seed::getNodes() {
+const vector<V> &Seed::getNodes() {
     return nodes;
 }
 
@@ -453,23 +481,13 @@ int Seed::getNumberOfNodes() {
 
 inline bool Seed::contains(V theNode) {
     //return true if the node is contained in this seed
-    if (this->nodes.find(theNode) != this->nodes.end()) {
-        return true;
-    } else {
-        return false;
-    }
+    return binary_search(this->nodes.begin(), this->nodes.end(), theNode);
 
 }
 
 inline bool Seed::frontierContains(V theNode) {
     //return true if the node is contained in the frontier
-    if (this->frontierNodeToInternalAndExternalEdges.find(theNode) !=
-        this->frontierNodeToInternalAndExternalEdges.end()) {
-        //its on the frontier
-        return true;
-    } else {
-        return false;
-    }
+    return this->frontier.contains(theNode);
 }
 
 
@@ -494,7 +512,7 @@ void Seed::rawPrintInOrderOfAddition() {
 }
 
 void Seed::rawPrint() {
-    for (set<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
+    for (vector<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
         cout << theGlobalGraph.name_of_one_node_asString((*innerSeedItr)) << " ";
     }
     cout << endl;
@@ -504,7 +522,7 @@ void Seed::prettyPrint() {
 
     cerr << "Seed: Members:";
 
-    for (set<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
+    for (vector<V>::iterator innerSeedItr = this->nodes.begin(); innerSeedItr != this->nodes.end(); ++innerSeedItr) {
         cerr << " " << (*innerSeedItr);
     }
     cerr << " Internal Edges: " << this->getInternalEdges() << " External Edges:" << this->getExternalEdges()
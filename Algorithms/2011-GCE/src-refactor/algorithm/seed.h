@@ -15,6 +15,13 @@
 #include <algorithm>
 
 #include "../util/graph/graph_representation.hpp"
+#include "frontier.h"
+#include "node_to_seeds.h"
+
+//The overlap check counts the nodes shared with each seed in one walk of the node->seeds index. Defining this also
+//runs the original check, which intersects the nodes of every seed found there, uses its answer, and counts the
+//checks where the two disagree.
+//#define OVERLAP_EXHAUSTIVE_CHECK
 
 //This class operates on a single representation of the graph, expected to be in global variable g
 extern SimpleIntGraph theGlobalGraph;
@@ -54,12 +61,15 @@ public:
 
     float addBestNodeFromFrontierToSeed();
 
+    //expand to the first peak of fitness; only reads the graph, so seeds can be expanded in parallel
+    void expand();
+
     //accessor methods
     int getInternalEdges();
 
     int getExternalEdges();
 
-    const set <V> &getNodes();
+    const vector<V> &getNodes();
 
     Seed();
 
@@ -77,6 +87,9 @@ public:
 
     bool overlapsAlreadyAcceptedSeed();
 
+    //number of overlap checks where the counting and the exhaustive checks disagreed
+    static long exhaustiveOverlapDisagreements;
+
     int getNumberOfNodes();
 
     bool dead;
@@ -93,7 +106,7 @@ public:
 private:
     //This vector stores the nodes that are in the graph.
     //This vector will be sorted.
-    set <V> nodes;
+    vector<V> nodes;
 
     vector<V> nodesInOrderOfAddition;
     int internalEdges;
@@ -101,12 +114,15 @@ private:
 
     bool cachesDirty;
 
+    bool overlapsAlreadyAcceptedSeedCounting();
+
+    bool overlapsAlreadyAcceptedSeedExhaustive();
+
     //Store the internal and external edges of each node that is in the frontier of the seed.
-    map<V, pair<int, int> > frontierNodeToInternalAndExternalEdges;
-    //Need a map of node to fitness for the frontier.
+    Frontier frontier;
 
 };
 
-extern vector<std::set<Seed *>> nodeToSeeds;
+extern NodeToSeedsIndex nodeToSeeds;
 
 #endif /* SEED_H_ */
@@ -1,7 +1,5 @@
 #include "grouping.hpp"
 
-#include <boost/unordered_set.hpp>
-
 #include "util/range.hpp"
 
 namespace grouping {
@@ -45,20 +43,27 @@ namespace grouping {
         assert(vs.empty());
     }
 
+    bool Group::contains(V v) const {
+        return binary_search(_vs.begin(), _vs.end(), v);
+    }
+
     Group *Grouping::newG() { return this->newG(false); }
 
     Group *Grouping::newG(bool randomized_p_in) {
         Group *g = new Group();
         g->_randomized_p_in = randomized_p_in;
         _groups.insert(g);
+        if (_groupsById.size() <= size_t(g->_id))
+            _groupsById.resize(g->_id + 1, NULL);
+        _groupsById[g->_id] = g;
         return g;
     }
 
     void Grouping::isolate(V v) {
-        set<Group *> grps = vgroups(
+        GroupIds grps = vgroups(
                 v); // I'm copying it in here, as we'll be modifying the node's vgroup as we delete nodes.
-        ForeachContainer (Group *grp, grps) {
-                    this->delV(grp, v);
+        ForeachContainer (int id, grps) {
+                    this->delV(this->group(id), v);
                 }
     }
 
@@ -90,20 +95,19 @@ namespace grouping {
         const V *edgeVN_ptr = _g.neighbours(v).first;
         const V *last = _g.neighbours(v).second;
 
-        boost::unordered_set<V> unset;
-        unset.insert(grp->vs.begin(), grp->vs.end());
-
         for (; edgeVN_ptr != last; ++edgeVN_ptr) {
-            if (unset.count(*edgeVN_ptr)) {
+            if (grp->contains(*edgeVN_ptr)) {
                 FixGlobalEdgeCounts(edgeVN_ptr, true);
             }
         }
-        bool was_inserted = grp->_vs.insert(v).second;
-        assert(was_inserted); // ensure the node wasn't there previously
+        vector<V>::iterator position = lower_bound(grp->_vs.begin(), grp->_vs.end(), v);
+        assert(position == grp->_vs.end() || *position != v); // ensure the node wasn't there previously
+        grp->_vs.insert(position, v);
 
-        if (_vgroups[v].empty())
+        GroupIds &vgroup = _vgroups[v];
+        if (vgroup.empty())
             ++nodes_in_at_least_one_comm;
-        _vgroups[v].insert(grp);
+        vgroup.insert(lower_bound(vgroup.begin(), vgroup.end(), grp->_id), grp->_id);
     }
 
     void Grouping::delV(Group *grp, V v) {
@@ -112,21 +116,21 @@ namespace grouping {
         const V *edgeVN_ptr = _g.neighbours(v).first;
         const V *last = _g.neighbours(v).second;
 
-        boost::unordered_set<V> unset;
-        unset.insert(grp->vs.begin(), grp->vs.end());
-
         for (; edgeVN_ptr != last; ++edgeVN_ptr) {
-            if (unset.count(*edgeVN_ptr)) {
+            if (grp->contains(*edgeVN_ptr)) {
                 FixGlobalEdgeCounts(edgeVN_ptr, false);
             }
         }
-        set<Group *> &vgroup = _vgroups.at(v);
-        vgroup.erase(grp);
+        GroupIds &vgroup = _vgroups.at(v);
+        GroupIds::iterator id = lower_bound(vgroup.begin(), vgroup.end(), grp->_id);
+        if (id != vgroup.end() && *id == grp->_id)
+            vgroup.erase(id);
         if (vgroup.size() == 0) {
             --nodes_in_at_least_one_comm;
         }
-        bool erased = grp->_vs.erase(v);
-        assert(erased == 1);
+        vector<V>::iterator position = lower_bound(grp->_vs.begin(), grp->_vs.end(), v);
+        assert(position != grp->_vs.end() && *position == v);
+        grp->_vs.erase(position);
         if (grp->vs.size() == 0)
             deleteEmptyGroup(this, grp);
     }
@@ -137,20 +141,26 @@ namespace grouping {
 
         Grouping &ging = *pging;
         ForeachContainer(V v, grp->vs) {
-                    ging._vgroups.at(v).erase(grp);
-                    if (ging._vgroups.at(v).size() == 0) {
+                    GroupIds &vgroup = ging._vgroups.at(v);
+                    vgroup.erase(remove(vgroup.begin(), vgroup.end(), grp->_id), vgroup.end());
+                    if (vgroup.size() == 0) {
                         --ging.nodes_in_at_least_one_comm;
                     }
                 }
         grp->_vs.clear();
         ging._groups.erase(grp);
+        ging._groupsById[grp->_id] = NULL;
         delete grp;
     }
 
-    const set<Group *> &Grouping::vgroups(V v) const {
+    const GroupIds &Grouping::vgroups(V v) const {
         return _vgroups[v];
     }
 
+    Group *Grouping::group(int id) const {
+        return _groupsById[id];
+    }
+
     size_t Grouping::vgroups_size() const {
         return nodes_in_at_least_one_comm;
     }
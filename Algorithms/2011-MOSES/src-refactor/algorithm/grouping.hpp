@@ -1,6 +1,8 @@
 #include <set>
+#include <vector>
 
 #include <boost/unordered_map.hpp>
+#include <boost/container/small_vector.hpp>
 
 #include "util/graph/graph_representation.hpp"
 
@@ -10,6 +12,9 @@ namespace grouping {
 
     class Grouping;
 
+    // the _ids of the groups a node is in, sorted. Most nodes are in very few groups, so a few are stored inline
+    typedef boost::container::small_vector<int, 4> GroupIds;
+
     struct orderGroup {
         int operator()(const Group *l, const Group *rl) const;
     };
@@ -33,7 +38,9 @@ namespace grouping {
         void addV(Group *, V v);
 
         void delV(Group *, V v); // warning. This will delete the group if v is the last node in it.
-        const set<Group *> &vgroups(V v) const;
+        const GroupIds &vgroups(V v) const;
+
+        Group *group(int id) const; // the group with this _id. NULL if it has been deleted
 
         size_t vgroups_size() const;
 
@@ -47,7 +54,8 @@ namespace grouping {
         };
 
         std::set<Group *, orderGroup> _groups;
-        vector<set<Group *> > _vgroups; // TODO: Make this a multimap?
+        vector<GroupIds> _vgroups;
+        vector<Group *> _groupsById; // indexed by _id. The ids are never reused, so the order of the groups doesn't change
 
     public:
         int comm_count_per_edge(V r, const V *edgeLR_ptr) const;
@@ -71,12 +79,15 @@ namespace grouping {
 
     class Group {
     public:
-        const set<V> &vs; // read-only public member . But we mustn't ever copy construct - I should avoid this idea, unless I am sure I've got the copy constructor(s) right.
+        const vector<V> &vs; // read-only public member, sorted. But we mustn't ever copy construct - I should avoid this idea, unless I am sure I've got the copy constructor(s) right.
         const int _id;
         int _randomized_p_in; // how was this group created. Was it still when I was using random p_ins?
         static int arbitraryID;
+
+        bool contains(V v) const;
+
     private:
-        set<V> _vs; // vertices in this group
+        vector<V> _vs; // vertices in this group, sorted
         explicit Group();
 
         ~Group();
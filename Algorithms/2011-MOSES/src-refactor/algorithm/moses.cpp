@@ -29,6 +29,7 @@ int main(int argc, char **argv) {
                     {"maxDegree",       required_argument, 0, 20},
                     {"saveMOSESscores", required_argument, 0, 21},
                     {"seed",            required_argument, 0, 22},
+                    {"loadOverlapping", required_argument, 0, 23},
                     {0, 0,                                 0, 0}
             };
             /* getopt_long stores the option index here. */
@@ -58,6 +59,9 @@ int main(int argc, char **argv) {
                 case 22: // --seed= {"seed", required_argument,         0, 22},
                     option_seed = atol(optarg);
                     break;
+                case 23: // --loadOverlapping= {"loadOverlapping", required_argument,         0, 23},
+                    strcpy(option_loadOverlapping, optarg);
+                    break;
 
             }
         }
@@ -72,6 +76,9 @@ int main(int argc, char **argv) {
         cout
                 << " [--saveMOSESscores FILENAME]: store the delta-objective for each community here (log-ratio of the MOSES posterior density). "
                 << endl;
+        cout
+                << " [--loadOverlapping FILENAME]: start from this grouping, one community per line, instead of an empty one. "
+                << endl;
         cout << endl;
         cout << "MOSES v2011-01-26b: This software is made available under the Apache License 2.0. " << endl;
         cout
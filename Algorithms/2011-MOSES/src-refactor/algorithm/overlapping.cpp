@@ -8,7 +8,6 @@
  *   unordered_map for efficiency more often?
  *   a big vector for the comm_count_per_edge?
  *   keep track of frontier properly in growingSeed
- *   type tags for the multi_index_container, instead of get<1>
  *   random tie-breaking in frontier
  *   update _p_in also.
  *
@@ -45,11 +44,6 @@
 #include <sstream>
 
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/indexed_by.hpp>
-#include <boost/multi_index/member.hpp>
 #include <boost/unordered_map.hpp>
 #include <boost/unordered_set.hpp>
 
@@ -57,6 +51,7 @@
 #include "util/program_options/options.hpp"
 #include "util/range.hpp"
 #include "algorithm/grouping.hpp"
+#include "algorithm/score_queue.hpp"
 
 using namespace std;
 using namespace std::tr1;
@@ -128,6 +123,7 @@ namespace overlapping {
         printf("env: MaxCommSize %s\n", getenv("MaxCommSize"));
         printf("env: OUTER_ITERS %s\n", getenv("OUTER_ITERS"));
         printf("env: LOUVAIN_ITERS %s\n", getenv("LOUVAIN_ITERS"));
+        printf("env: LOUVAIN_BATCH %s\n", getenv("LOUVAIN_BATCH"));
         printf("NoBroken\n");
         srand48(option_seed); // default seed. Will be changeable by command line arg.
 /*
@@ -435,7 +431,7 @@ namespace overlapping {
                    log2l(1.0L - _ging._p_in) * (_group_size_smaller - count_edges_back_into_this_group);
         }
 
-        explicit DeltaSeed(V v, int group_size_smaller, Grouping &ging) : _v(v),
+        explicit DeltaSeed(V v, int group_size_smaller, const Grouping &ging) : _v(v),
                                                                           _group_size_smaller(group_size_smaller),
                                                                           _ging(ging), _deltadeltaEdgeEntropy(0.0L),
                                                                           count_edges_back_into_this_group(0) {
@@ -478,32 +474,7 @@ namespace overlapping {
         }
     };
 
-    struct FrontierNode {
-        FrontierNode(long double &score, V v) : _score(score), _v(v) {}
-
-        long double _score;
-        V _v;
-
-        struct Incrementer {
-            long double _x;
-
-            Incrementer(long double &x) : _x(x) {}
-
-            void operator()(FrontierNode &fn) const { fn._score += _x; }
-        };
-    };
-
-    using namespace boost::multi_index;
-    struct VertexTag {
-    };
-
-    struct Frontier : private multi_index_container< // TODO: Some sort of binary tree sometime?
-            FrontierNode,
-            indexed_by<
-                    ordered_non_unique<member<FrontierNode, long double, &FrontierNode::_score>, greater<long double> >,
-                    hashed_unique<tag<VertexTag>, member<FrontierNode, V, &FrontierNode::_v> >
-            >
-    > {
+    struct Frontier : private ScoreQueue<V> {
         // vertices, and their scores.
         // easy removal of the highest-score vertices.
         // easy increase of score of arbitrary members, adding them if they don't exist already.
@@ -522,32 +493,24 @@ namespace overlapping {
             //assert(*edgeFT_ptr == to);
             int sharedCommunities = ging.comm_count_per_edge(to, edgeFT_ptr); // a little time in here
             long double deltadeltaEdgeEntropy = calcddEE(ging, sharedCommunities /*, to*/); // a little time in here
-
-            Frontier::nth_index<1>::type::iterator addOrModifyThis = this->get<1>().find(to);
-            if (addOrModifyThis == this->get<1>().end()) { // TODO: faster if search for to is done just once?
-                this->insert(FrontierNode(deltadeltaEdgeEntropy, to));
-            } else {
-                this->get<1>().modify(addOrModifyThis, FrontierNode::Incrementer(deltadeltaEdgeEntropy));
-            }
+            // calcddEE is always positive, so the scores only increase
+            this->increase(to, deltadeltaEdgeEntropy);
         }
 
         void erase_best_node() {
-            Frontier::iterator best_node = this->get<0>().begin();
-            this->erase(best_node);
+            this->erase_best();
         }
 
         int erase_this_node(V to) {
-            return this->get<1>().erase(to);
+            return this->erase(to);
         }
 
-        long double best_node_score() const {
-            Frontier::iterator best_node = this->get<0>().begin();
-            return best_node->_score;
+        long double best_node_score() {
+            return this->best_score();
         }
 
-        V best_node_v() const {
-            Frontier::iterator best_node = this->get<0>().begin();
-            return best_node->_v;
+        V best_node_v() {
+            return this->best_v();
         }
 
         bool Empty() const {
@@ -784,91 +747,152 @@ namespace overlapping {
 
     typedef boost::unordered_map<Group *, DeltaSeed, hashGroup> SeedDeltasT;
 
+    // The groups v should be in, in the order louvainStyle adds v back to them once v has been isolated.
+    // Only reads the grouping, so the moves of several nodes can be evaluated at once: after isolating v, none of
+    // its edges is in a shared community, and each group v is in is one node smaller.
+    static void louvainMove(const Grouping &ging, V v, vector<Group *> &joins) {
+        SeedDeltasT _seedDeltas;
+        {
+            IteratorRange<const V *> ns(ging._g.neighbours(v));
+            Foreach(V n, ns) {
+                        for (int id: ging.vgroups(n)) {
+                            Group *grp = ging.group(id);
+                            const int size_without_v = grp->vs.size() - (grp->contains(v) ? 1 : 0);
+                            _seedDeltas.insert(make_pair(grp, DeltaSeed(v, size_without_v, ging))).first->second.addEdge(n,
+                                                                                                                      0);
+                        }
+                    }
+        }
+        vector<int> sharedCommunities(ging._g.degree(v), 0); // for each edge of v, as v is added back to groups
+
+        for (int addedBack = 0; _seedDeltas.size() > 0; addedBack++) {
+
+            // for each neighbouring group, calculate the delta-entropy of expanding back in here.
+            pair<long double, Group *> bestGroup(-LDBL_MAX, (Group *) NULL);
+            int num_positive = 0;
+            for (SeedDeltasT::iterator i = _seedDeltas.begin(); i != _seedDeltas.end();) {
+                if (i->second._deltaTotalentropy() <= 0.0L) {
+                    i = _seedDeltas.erase(i);
+                    continue;
+                } else {
+                    long double delta2 = i->second._deltaTotalentropy();
+                    // TODO: Count the positive scores. No point proceeding if there aren't any more positive scores, as they can only decrease
+                    if (bestGroup.first < delta2)
+                        bestGroup = make_pair(delta2, i->first);
+                    if (delta2 > 0.0L)
+                        ++num_positive;
+                }
+                ++i;
+            }
+            if (bestGroup.first > 0.0L) {
+                assert(num_positive >= 1);
+                joins.push_back(bestGroup.second);
+                if (num_positive ==
+                    1) { // if just one was positive, then there's no point continuing, as the rest will only lose more score.
+                    break;
+                }
+
+                _seedDeltas.erase(bestGroup.second);
+
+                // the other potential groups on the end of this edge need to have their addEdge undone
+                int edge = 0;
+                IteratorRange<const V *> ns(ging._g.neighbours(v));
+                Foreach(V n, ns) {
+                            if (bestGroup.second->contains(n)) {
+                                int previous_sharedCommunities = sharedCommunities[edge]++;
+                                for (int id:ging.vgroups(n)) {
+                                    SeedDeltasT::iterator grpInSeed = _seedDeltas.find(ging.group(id));
+                                    if (grpInSeed != _seedDeltas.end()) {
+                                        const long double before = grpInSeed->second._deltaTotalentropy();
+                                        grpInSeed->second.redoEdge(n, previous_sharedCommunities);
+                                        const long double after = grpInSeed->second._deltaTotalentropy();
+                                        if (after > before) {
+                                            Perror("%s:%d _deltaTotalentropy %Lg -> %Lg\n", __FILE__,
+                                                   __LINE__, before, after);
+                                        }
+                                    }
+                                }
+                            }
+                            ++edge;
+                        }
+            } else
+                break;
+        }
+    }
+
+    static void applyMove(Grouping &ging, V v, const vector<Group *> &joins) {
+        ging.isolate(v);
+        for (Group *grp: joins) {
+            ging.addV(grp, v);
+        }
+    }
+
+    // Adds v to the batch unless v or one of its neighbours is already in it. The move of v changes only the groups of
+    // v and the edges of v, and reads the groups of its neighbours, so the moves of a batch can all be evaluated
+    // before any is applied. The sizes of the groups may have changed by the time a move is applied, but addV and delV
+    // keep all the counts exact whatever the moves are.
+    static bool joinBatch(const Grouping &ging, V v, int batch, vector<int> &nodeBatch) {
+        if (nodeBatch[v] == batch)
+            return false;
+        {
+            IteratorRange<const V *> ns(ging._g.neighbours(v));
+            Foreach(V n, ns) {
+                        if (nodeBatch[n] == batch)
+                            return false;
+                    }
+        }
+        nodeBatch[v] = batch;
+        return true;
+    }
+
     template<class N>
     static void louvainStyle(Grouping &ging, bloomGraph<N> &g) {
         Timer t(__FUNCTION__);
         // find a node, isolate it from its communities, Add back one at a time if appropriate.
         const bool DEBUG_louvainStyle = 0;
-        for (V v = 0; v < g.vcount(); v++) {
+        // The nodes are moved in batches of up to LOUVAIN_BATCH nodes, no two of them neighbours, taken in order from a
+        // window of the next nodes; a node next to one in the batch waits for a later batch. The moves of a batch are
+        // evaluated in parallel against the grouping as it was before the batch, and then applied in order, so the
+        // result doesn't depend on the number of threads. The oldest waiting node always gets in.
+        // By default LOUVAIN_BATCH=1: the nodes are moved one at a time in order, which is the original algorithm.
+        // Larger batches are opt-in. They spread the evaluation of the moves over the threads, but a node no longer
+        // sees the moves made earlier in its batch, and the nodes are visited in a different order, so the groups
+        // found change (e.g. 42 groups and objective -200990 instead of 44 and -200972 on a planted partition graph
+        // with LOUVAIN_BATCH=256).
+        const int max_batch = DEBUG_louvainStyle ? 1 : max(1, atoi(getenv("LOUVAIN_BATCH") ?: "1"));
+        const size_t window = 4 * size_t(max_batch);
+        vector<int> nodeBatch(g.vcount(), -1);
+        vector<V> waiting, deferred, batch;
+        vector<vector<Group *> > joins;
+        V next = 0;
+        for (int batchNumber = 0; next < g.vcount() || !waiting.empty(); batchNumber++) {
+            while (waiting.size() < window && next < g.vcount())
+                waiting.push_back(next++);
             if (0) update_p_out(ging);
             // if(v%(g.vcount()/20)==0) PP(v);
             if (DEBUG_louvainStyle)
                 groupStats(ging, g);
             if (DEBUG_louvainStyle)
-                cout << "removing node in these many groups: " << ging.vgroups(v).size() << endl;
+                cout << "removing node in these many groups: " << ging.vgroups(waiting.front()).size() << endl;
 
-            ging.isolate(v);
-
-            SeedDeltasT _seedDeltas;
-            IteratorRange<const V *> ns(ging._g.neighbours(v));
-            {
-                const V *edgeVN_ptr = ging._g.neighbours(v).first;
-                Foreach(V n, ns) {
-                            int sharedCommunities = ging.comm_count_per_edge(n, edgeVN_ptr);
-                            // TODO: Could prepare the results for addEdge of v<>n
-                            for (Group *grp: ging.vgroups(n)) {
-                                _seedDeltas.insert(make_pair(grp, DeltaSeed(v, grp->vs.size(),
-                                                                            ging))).first->second.addEdge(n,
-                                                                                                          sharedCommunities);
-                                //_seedDeltas.find(grp)->second.addEdge(n, sharedCommunities);
-                            }
-                            ++edgeVN_ptr;
-                        }
+            batch.clear();
+            deferred.clear();
+            for (V v: waiting) {
+                if ((int) batch.size() < max_batch && joinBatch(ging, v, batchNumber, nodeBatch))
+                    batch.push_back(v);
+                else
+                    deferred.push_back(v);
             }
+            waiting.swap(deferred);
 
-            for (int addedBack = 0; _seedDeltas.size() > 0; addedBack++) {
-
-                // for each neighbouring group, calculate the delta-entropy of expanding back in here.
-                pair<long double, Group *> bestGroup(-LDBL_MAX, (Group *) NULL);
-                int num_positive = 0;
-                for (SeedDeltasT::iterator i = _seedDeltas.begin(); i != _seedDeltas.end();) {
-                    if (i->second._deltaTotalentropy() <= 0.0L) {
-                        i = _seedDeltas.erase(i);
-                        continue;
-                    } else {
-                        long double delta2 = i->second._deltaTotalentropy();
-                        // TODO: Count the positive scores. No point proceeding if there aren't any more positive scores, as they can only decrease
-                        if (bestGroup.first < delta2)
-                            bestGroup = make_pair(delta2, i->first);
-                        if (delta2 > 0.0L)
-                            ++num_positive;
-                    }
-                    ++i;
-                }
-                if (bestGroup.first > 0.0L) {
-                    assert(num_positive >= 1);
-                    ging.addV(bestGroup.second, v);
-                    if (num_positive ==
-                        1) { // if just one was positive, then there's no point continuing, as the rest will only lose more score.
-                        break;
-                    }
-
-                    _seedDeltas.erase(bestGroup.second);
-
-                    // the other potential groups on the end of this edge need to have their addEdge undone
-                    const V *edgeVN_ptr = ging._g.neighbours(v).first;
-                    IteratorRange<const V *> ns(ging._g.neighbours(v));
-                    Foreach(V n, ns) {
-                                assert(*edgeVN_ptr == n);
-                                if (bestGroup.second->vs.count(n)) {
-                                    int previous_sharedCommunities = ging.comm_count_per_edge(n, edgeVN_ptr) - 1;
-                                    for (Group *grp:ging.vgroups(n)) {
-                                        SeedDeltasT::iterator grpInSeed = _seedDeltas.find(grp);
-                                        if (grpInSeed != _seedDeltas.end()) {
-                                            const long double before = grpInSeed->second._deltaTotalentropy();
-                                            grpInSeed->second.redoEdge(n, previous_sharedCommunities);
-                                            const long double after = grpInSeed->second._deltaTotalentropy();
-                                            if (after > before) {
-                                                Perror("%s:%d _deltaTotalentropy %Lg -> %Lg\n", __FILE__,
-                                                       __LINE__, before, after);
-                                            }
-                                        }
-                                    }
-                                }
-                                ++edgeVN_ptr;
-                            }
-                } else
-                    break;
+            joins.resize(batch.size());
+#pragma omp parallel for schedule(dynamic, 16) if (batch.size() > 1)
+            for (size_t i = 0; i < batch.size(); i++) {
+                joins[i].clear();
+                louvainMove(ging, batch[i], joins[i]);
+            }
+            for (size_t i = 0; i < batch.size(); i++) {
+                applyMove(ging, batch[i], joins[i]);
             }
         }
     }
@@ -904,16 +928,18 @@ namespace overlapping {
             assert(sharedCommunities == ging.comm_count_per_edge2[e2].shared_comms);
             //Pn("%d\t%d", l, r);
             counter++;
-            const set<Group *> &lgrps = ging.vgroups(l);
-            const set<Group *> &rgrps = ging.vgroups(r);
+            const GroupIds &lgrps = ging.vgroups(l);
+            const GroupIds &rgrps = ging.vgroups(r);
             //PP(lgrps.size());
             //PP(rgrps.size());
-            vector<Group *> lonly, ronly;
+            vector<int> lonly, ronly;
             set_difference(lgrps.begin(), lgrps.end(), rgrps.begin(), rgrps.end(), back_inserter(lonly));
             set_difference(rgrps.begin(), rgrps.end(), lgrps.begin(), lgrps.end(), back_inserter(ronly));
             //Pn("# unmatched %zd,%zd", lonly.size(), ronly.size());
-            for (Group *lg: lonly) {
-                for (Group *rg:ronly) {
+            for (int lid: lonly) {
+                for (int rid:ronly) {
+                    Group *lg = ging.group(lid);
+                    Group *rg = ging.group(rid);
                     long double qi = 1.0L - ging._p_in;
                     long double qo = 1.0L - ging._p_out;
                     //const int64 oldQz = ging.groups.size();
@@ -969,15 +995,17 @@ namespace overlapping {
             assert(sharedCommunities == ging.comm_count_per_edge2[e2].shared_comms);
             //Pn("%d\t%d", l, r);
             counter++;
-            const set<Group *> &lgrps = ging.vgroups(l);
-            const set<Group *> &rgrps = ging.vgroups(r);
+            const GroupIds &lgrps = ging.vgroups(l);
+            const GroupIds &rgrps = ging.vgroups(r);
             //PP(lgrps.size());
             //PP(rgrps.size());
-            vector<Group *> inter;
+            vector<int> inter;
             set_intersection(lgrps.begin(), lgrps.end(), rgrps.begin(), rgrps.end(), back_inserter(inter));
             //Pn("# unmatched %zd,%zd", lonly.size(), ronly.size());
-            for (Group *lg: inter) {
-                for (Group *rg: inter) {
+            for (int lid: inter) {
+                for (int rid: inter) {
+                    Group *lg = ging.group(lid);
+                    Group *rg = ging.group(rid);
                     if (lg < rg) { // no point proposing a merge between a group and itself
                         long double qi = 1.0L - ging._p_in;
                         long double qo = 1.0L - ging._p_out;
@@ -1013,13 +1041,13 @@ namespace overlapping {
                 if (already_merged.count(merge_these.first) == 0 && already_merged.count(merge_these.second) == 0) {
                     Group *l = merge_these.first;
                     Group *r = merge_these.second;
-                    const set<V> these_nodes(l->vs); // copy them, so as to iterate properly over them.
+                    const vector<V> these_nodes(l->vs); // copy them, so as to iterate properly over them.
                     //P(" "); PP(ging.groups.size());
                     for (V v: these_nodes) {
-                        if (r->vs.count(v) == 0) {
+                        if (!r->contains(v)) {
                             ging.addV(r, v);
                         }
-                        assert(r->vs.count(v) == 1);
+                        assert(r->contains(v));
                         //ging.delV(l,v);
                     }
                     //PP(ging.groups.size());
@@ -1069,14 +1097,14 @@ namespace overlapping {
             V r = ging._g.neighbours(0).first[e];
             if (r < l) continue; // no point considering each edge twice
 
-            const set<Group *> &lgrps = ging.vgroups(l);
-            const set<Group *> &rgrps = ging.vgroups(r);
-            vector<Group *> sharedComms;
+            const GroupIds &lgrps = ging.vgroups(l);
+            const GroupIds &rgrps = ging.vgroups(r);
+            vector<int> sharedComms;
             set_intersection(lgrps.begin(), lgrps.end(), rgrps.begin(), rgrps.end(), back_inserter(sharedComms));
             assert((size_t) sharedCommunities == sharedComms.size());
 
-            for (Group *grp: sharedComms) {
-                DeletionsT::iterator pm = proposed_deletions.find(grp);
+            for (int id: sharedComms) {
+                DeletionsT::iterator pm = proposed_deletions.find(ging.group(id));
                 assert(pm != proposed_deletions.end());
                 pm->second +=
                         log2l(1.0L - (1.0L - ging._p_out) * powl(1.0L - ging._p_in, sharedCommunities))
@@ -1099,7 +1127,7 @@ namespace overlapping {
                 deletions_accepted++;
                 deletions_sizes[pm->first->vs.size()]++;
                 { // delete the group
-                    set<V> vs = pm->first->vs; // COPY the vertices in
+                    vector<V> vs = pm->first->vs; // COPY the vertices in
                     for (V v: vs) {
                         ging.delV(pm->first, v);
                     }
@@ -1108,8 +1136,7 @@ namespace overlapping {
             }
         }
         P("deletions_accepted: %d\t", deletions_accepted);
-        pair<V, int> delete_size;
-        for (delete_size: deletions_sizes) {
+        for (const pair<const V, int> &delete_size: deletions_sizes) {
             P("%d{%d} ", delete_size.second, delete_size.first);
         }
         P("\n");
@@ -1147,8 +1174,7 @@ namespace overlapping {
         // Qz!
         // product of binomial/N+1
         int64 sigma_shared_Xis1 = 0;
-        pair<int, V> edge_count;
-        for (edge_count: ging.global_edge_counts) {
+        for (const pair<const int, V> &edge_count: ging.global_edge_counts) {
             sigma_shared_Xis1 += edge_count.first * edge_count.second;
         }
         long double Pxz = P_x_given_z(ging, ging._p_out, ging._p_in, sigma_shared_Xis1);
@@ -1196,8 +1222,7 @@ namespace overlapping {
         const int64 N = ging._g.vcount();
         const int64 m = ging._g.ecount() / 2L;
         int64 sigma_shared_Xis1 = 0;
-        pair<int, V> edge_count;
-        for (edge_count: ging.global_edge_counts) {
+        for (const pair<const int, V> &edge_count: ging.global_edge_counts) {
             sigma_shared_Xis1 += edge_count.first * edge_count.second;
         }
         //PP(sigma_shared_Xis1);
@@ -1208,7 +1233,7 @@ namespace overlapping {
                 long double logP_XgivenZ = 0.0;
                 logP_XgivenZ += log2l(1.0L - p_o) * (N * (N - 1) / 2 - m);
                 logP_XgivenZ += log2l(1.0L - p_i) * (ging._sigma_shared - sigma_shared_Xis1);
-                for (edge_count: ging.global_edge_counts) {
+                for (const pair<const int, V> &edge_count: ging.global_edge_counts) {
                     const int64 s = edge_count.first;
                     const int64 m_s = edge_count.second;
                     logP_XgivenZ += log2l(1.0L - (1.0L - p_o) * powl(1.0L - p_i, s)) * m_s;
@@ -1218,8 +1243,7 @@ namespace overlapping {
             }
         }
 
-        pair<long double, pair<long double, long double> > best;
-        for (best: ALLlogP_XgivenZ) {
+        for (const pair<const long double, pair<long double, long double> > &best: ALLlogP_XgivenZ) {
             Pn("BEST: %Lg,%Lg -> %9.0Lf  ", best.second.first, best.second.second, best.first);
             ging._p_in = best.second.first;
             ging._p_out = best.second.second;
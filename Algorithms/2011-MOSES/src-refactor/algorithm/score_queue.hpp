@@ -0,0 +1,115 @@
+#ifndef _SCORE_QUEUE_HPP_
+#define _SCORE_QUEUE_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+namespace overlapping {
+
+    // Vertices and their scores, for the frontier of a growing seed.
+    // The scores may only increase, which is all the frontier needs, and then a vertex can simply be appended to the
+    // bucket of its new score, leaving a stale entry behind in the old bucket. Adding to a score is O(1). The best
+    // vertex is searched for lazily, only when asked for, in the highest bucket, dropping the stale entries on the way.
+    // Of several vertices with the same best score, the one whose score was set first is the best, just like the
+    // ordered_non_unique index of the multi_index_container this replaces.
+    template<class V>
+    class ScoreQueue {
+    public:
+        explicit ScoreQueue(long double bucketWidth = 1.0L) : _bucketWidth(bucketWidth), _top(-1), _bestValid(false) {}
+
+        // Adds x to the score of v, adding v with score x if it isn't in the queue yet. x must be positive.
+        void increase(V v, long double x) {
+            assert(x >= 0.0L);
+            std::pair<typename ScoresT::iterator, bool> inserted = _scores.insert(std::make_pair(v, x));
+            if (!inserted.second)
+                inserted.first->second += x;
+            const long double score = inserted.first->second;
+            const int b = bucket(score);
+            if (b >= (int) _buckets.size())
+                _buckets.resize(b + 1);
+            _buckets[b].push_back(Entry(v, score));
+            if (b > _top)
+                _top = b;
+            _bestValid = false;
+        }
+
+        // Returns 1 if v was in the queue.
+        int erase(V v) {
+            _bestValid = false;
+            return _scores.erase(v);
+        }
+
+        void erase_best() {
+            findBest();
+            std::vector<Entry> &top = _buckets[_top];
+            _scores.erase(top[_best]._v);
+            top.erase(top.begin() + _best);
+            _bestValid = false;
+        }
+
+        long double best_score() {
+            findBest();
+            return _buckets[_top][_best]._score;
+        }
+
+        V best_v() {
+            findBest();
+            return _buckets[_top][_best]._v;
+        }
+
+        bool empty() const { return _scores.empty(); }
+
+        size_t size() const { return _scores.size(); }
+
+    private:
+        struct Entry {
+            Entry(V v, long double score) : _v(v), _score(score) {}
+
+            V _v;
+            long double _score; // the entry is stale unless this is still the score of _v
+        };
+
+        typedef boost::unordered_map<V, long double> ScoresT;
+
+        int bucket(long double score) const {
+            return score > 0.0L ? int(score / _bucketWidth) : 0;
+        }
+
+        // Compacts the highest bucket with a current entry, keeping the order of the entries, and finds its best one.
+        void findBest() {
+            if (_bestValid)
+                return;
+            assert(!empty());
+            for (;; --_top) {
+                assert(_top >= 0);
+                std::vector<Entry> &top = _buckets[_top];
+                size_t kept = 0;
+                for (size_t i = 0; i < top.size(); ++i) {
+                    typename ScoresT::const_iterator current = _scores.find(top[i]._v);
+                    if (current == _scores.end() || current->second != top[i]._score)
+                        continue;
+                    if (kept == 0 || top[i]._score > top[_best]._score)
+                        _best = kept;
+                    top[kept++] = top[i];
+                }
+                top.resize(kept, Entry(V(), 0.0L));
+                if (kept > 0)
+                    break;
+            }
+            _bestValid = true;
+        }
+
+        const long double _bucketWidth;
+        ScoresT _scores;
+        std::vector<std::vector<Entry> > _buckets;
+        int _top; // no bucket above this one has a current entry
+        size_t _best; // in _buckets[_top], if _bestValid
+        bool _bestValid;
+    };
+
+} // namespace overlapping
+
+#endif
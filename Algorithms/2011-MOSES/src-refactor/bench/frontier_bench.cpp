@@ -0,0 +1,191 @@
+/* Benchmark of the frontier used to grow the seeds, the ScoreQueue against the multi_index_container it replaced.
+ *
+ * Seeds are grown from random edges of the graph like growingSeed does: the frontier starts with the neighbours of
+ * both ends of the edge, then the best vertex is repeatedly moved into the seed and its neighbours added to the
+ * frontier, or their scores increased. The score increases are drawn from the few values calcddEE can take. Both
+ * frontiers are fed exactly the same operations, and must pick the same vertices.
+ *
+ * Usage: frontier_bench EDGEFILE [SEEDS [SEED_SIZE]]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/indexed_by.hpp>
+#include <boost/multi_index/member.hpp>
+
+#include "algorithm/score_queue.hpp"
+
+using namespace std;
+
+typedef int V;
+
+// The frontier as it was, without the Grouping.
+namespace old {
+
+    struct FrontierNode {
+        FrontierNode(long double &score, V v) : _score(score), _v(v) {}
+
+        long double _score;
+        V _v;
+
+        struct Incrementer {
+            long double _x;
+
+            Incrementer(long double &x) : _x(x) {}
+
+            void operator()(FrontierNode &fn) const { fn._score += _x; }
+        };
+    };
+
+    using namespace boost::multi_index;
+    struct VertexTag {
+    };
+
+    struct Frontier : private multi_index_container<
+            FrontierNode,
+            indexed_by<
+                    ordered_non_unique<member<FrontierNode, long double, &FrontierNode::_score>, greater<long double> >,
+                    hashed_unique<tag<VertexTag>, member<FrontierNode, V, &FrontierNode::_v> >
+            >
+    > {
+    public:
+        void increase(V to, long double x) {
+            Frontier::nth_index<1>::type::iterator addOrModifyThis = this->get<1>().find(to);
+            if (addOrModifyThis == this->get<1>().end()) {
+                this->insert(FrontierNode(x, to));
+            } else {
+                this->get<1>().modify(addOrModifyThis, FrontierNode::Incrementer(x));
+            }
+        }
+
+        void erase_best() { this->get<0>().erase(this->get<0>().begin()); }
+
+        int erase(V to) { return this->get<1>().erase(to); }
+
+        long double best_score() const { return this->get<0>().begin()->_score; }
+
+        V best_v() const { return this->get<0>().begin()->_v; }
+
+        bool empty() const { return multi_index_container::empty(); }
+    };
+
+} // namespace old
+
+struct Graph {
+    vector<vector<V> > neighbours;
+    vector<pair<V, V> > edges;
+};
+
+static bool loadGraph(const char *fileName, Graph &g) {
+    ifstream in(fileName);
+    if (!in)
+        return false;
+    long l, r;
+    while (in >> l >> r) {
+        if (l == r)
+            continue;
+        if ((size_t) max(l, r) >= g.neighbours.size())
+            g.neighbours.resize(max(l, r) + 1);
+        g.neighbours[l].push_back(r);
+        g.neighbours[r].push_back(l);
+        g.edges.push_back(make_pair(V(l), V(r)));
+        in.ignore(1000, '\n');
+    }
+    for (vector<V> &ns: g.neighbours) {
+        sort(ns.begin(), ns.end());
+        ns.erase(unique(ns.begin(), ns.end()), ns.end());
+    }
+    return true;
+}
+
+// calcddEE for p_in 0.4 and p_out 0.001, by the number of communities an edge is already in.
+static vector<long double> edgeScores() {
+    const long double p_in = 0.4L, p_out = 0.001L;
+    vector<long double> scores;
+    for (int shared = 0; shared < 4; ++shared)
+        scores.push_back(log2l(1.0L - (1.0L - p_out) * powl(1.0L - p_in, 1 + shared))
+                         - log2l(1.0L - (1.0L - p_out) * powl(1.0L - p_in, shared))
+                         - log2l(1.0L - p_in));
+    return scores;
+}
+
+// Most edges are in no community yet, a few in one or more.
+static long double edgeScore(const vector<long double> &scores, V l, V r) {
+    const unsigned h = (unsigned(min(l, r)) * 2654435761U) ^ (unsigned(max(l, r)) * 40503U);
+    const unsigned x = (h >> 7) % 16;
+    return scores[x < 12 ? 0 : x < 14 ? 1 : x < 15 ? 2 : 3];
+}
+
+template<class FrontierT>
+static double growSeeds(const Graph &g, const vector<size_t> &startEdges, size_t seedSize, vector<V> &picked) {
+    const vector<long double> scores = edgeScores();
+    const clock_t start = clock();
+    for (size_t e: startEdges) {
+        const V l = g.edges[e].first, r = g.edges[e].second;
+        FrontierT frontier;
+        set<V> seed;
+        seed.insert(l);
+        seed.insert(r);
+        for (V n: g.neighbours[l])
+            if (n != r)
+                frontier.increase(n, edgeScore(scores, l, n));
+        for (V n: g.neighbours[r])
+            if (n != l)
+                frontier.increase(n, edgeScore(scores, r, n));
+        while (seed.size() < seedSize && !frontier.empty()) {
+            const V best = frontier.best_v();
+            picked.push_back(best);
+            frontier.erase_best();
+            for (V n: g.neighbours[best])
+                if (seed.count(n) == 0)
+                    frontier.increase(n, edgeScore(scores, best, n));
+            seed.insert(best);
+        }
+    }
+    return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " EDGEFILE [SEEDS [SEED_SIZE]]" << endl;
+        return 1;
+    }
+    Graph g;
+    if (!loadGraph(argv[1], g) || g.edges.empty()) {
+        cerr << "Couldn't read any edges from " << argv[1] << endl;
+        return 1;
+    }
+    const size_t seeds = argc > 2 ? atol(argv[2]) : 10000;
+    const size_t seedSize = argc > 3 ? atol(argv[3]) : 30;
+
+    srand48(0);
+    vector<size_t> startEdges;
+    for (size_t i = 0; i < seeds; ++i)
+        startEdges.push_back(size_t(drand48() * g.edges.size()));
+
+    vector<V> pickedOld, pickedNew;
+    const double oldTime = growSeeds<old::Frontier>(g, startEdges, seedSize, pickedOld);
+    const double newTime = growSeeds<overlapping::ScoreQueue<V> >(g, startEdges, seedSize, pickedNew);
+
+    printf("%zu seeds of up to %zu vertices, %zu vertices picked\n", seeds, seedSize, pickedOld.size());
+    printf("multi_index_container: %f s\n", oldTime);
+    printf("ScoreQueue:            %f s\n", newTime);
+    if (pickedOld != pickedNew) {
+        printf("The frontiers picked different vertices!\n");
+        return 1;
+    }
+    printf("Both frontiers picked the same vertices.\n");
+    return 0;
+}
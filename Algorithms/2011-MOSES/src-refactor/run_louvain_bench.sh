@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+# Times the Louvain-style node moves of MOSES on an LFR graph, starting from the planted communities.
+# Usage: [BATCHES="1 16 64 256 1024"] ./run_louvain_bench.sh [N] [threads...]
+# LOUVAIN_BATCH=1 is the default, sequential algorithm; the batched runs find different groups.
+# Prints the time of the node moves, the final number of groups, the final objective (Pz + P(x|z)) and its ratio to the
+# objective without communities of each run.
+N=${1:-1000000}
+shift
+THREADS=${@:-1 2 4 8}
+BATCHES=${BATCHES:-1 16 64 256 1024}
+
+LFR=../../../Benchmark/2009-LFR-Benchmark/src_refactor_cpp
+
+mkdir -p build
+cd build
+cmake ..
+make
+cd ..
+(mkdir -p $LFR/build && cd $LFR/build && cmake .. && make lfr_undir_net)
+
+mkdir -p louvain_bench
+cd louvain_bench
+if [ ! -f network.dat ]; then
+    ../$LFR/build/undirected_graph/lfr_undir_net -N $N -k 15 -maxk 50 -mu 0.1 -minc 20 -maxc 50 -on $((N / 10)) -om 2
+fi
+# community.dat has one node per line with its communities, the grouping file one community per line
+awk '{ for (i = 2; i <= NF; i++) members[$i] = members[$i] " " $1 } END { for (c in members) print substr(members[c], 2) }' community.dat > groups.txt
+
+# every run is compared with the first one of LOUVAIN_BATCH=1, the sequential algorithm, which is always made first
+FIRST=`echo $THREADS | cut -d' ' -f1`
+for batch in 1 `echo " $BATCHES " | sed 's/ 1 / /g'`; do
+    for t in $THREADS; do
+        OMP_NUM_THREADS=$t LOUVAIN_BATCH=$batch OUTER_ITERS=0 LOUVAIN_ITERS=1 \
+            ../build/2011-moses network.dat out_${batch}_$t.txt --loadOverlapping groups.txt > log_${batch}_$t.txt
+        echo "LOUVAIN_BATCH=$batch threads=$t:" \
+            "`grep 'Timer louvainStyle' log_${batch}_$t.txt | tail -1 | sed 's/^ *//'`," \
+            "`grep '^#groups=' log_${batch}_$t.txt | tail -1 | cut -d. -f1`," \
+            "`grep '^Compression:' log_${batch}_$t.txt | tail -1 | awk '{ printf "objective %.0f, compression %s", $3 + $4, $2 }'`"
+        cmp -s out_${batch}_$t.txt out_1_$FIRST.txt || echo "  output differs from LOUVAIN_BATCH=1 threads=$FIRST"
+    done
+done
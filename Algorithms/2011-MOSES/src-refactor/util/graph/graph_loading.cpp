@@ -181,8 +181,8 @@ namespace graph_loading {
             Foreach(edge, roe2) {
                         sigUSR1_state.edge_counter++;
                         if (edge.first != edge.second) {
-                            assert(degree.get<NameTag>().count(edge.first) == 1);
-                            assert(degree.get<NameTag>().count(edge.second) == 1);
+                            assert(degree.template get<NameTag>().count(edge.first) == 1);
+                            assert(degree.template get<NameTag>().count(edge.second) == 1);
                             bool was_inserted = edges.insert(edge).second;
                             swap(edge.first, edge.second);
                             bool was_inserted2 = edges.insert(
@@ -190,11 +190,11 @@ namespace graph_loading {
                             assert(was_inserted == was_inserted2);
 
                             if (was_inserted) {
-                                degree.get<NameTag>().modify(
-                                        degree.get<NameTag>().find(edge.first), DegreeIncrementer<Name>
+                                degree.template get<NameTag>().modify(
+                                        degree.template get<NameTag>().find(edge.first), DegreeIncrementer<Name>
                                 );
-                                degree.get<NameTag>().modify(
-                                        degree.get<NameTag>().find(edge.second), DegreeIncrementer<Name>
+                                degree.template get<NameTag>().modify(
+                                        degree.template get<NameTag>().find(edge.second), DegreeIncrementer<Name>
                                 );
                             }
                         }
@@ -217,7 +217,7 @@ namespace graph_loading {
                 cout << "before deletion, ";
                 PP(names->size());
                 Timer timer("deleting high degree nodes");
-                PP(degree.get<DegreeTag>().begin()->second);
+                PP(degree.template get<DegreeTag>().begin()->second);
                 // we could remove nodes and edges here, just remember to delete from names if necessary.
                 // const V max_degree = 1000; // fail at neighbours_left==3
                 // const V max_degree = 400,000; // 2 nodes  3.2 s
@@ -225,9 +225,9 @@ namespace graph_loading {
                 // const V max_degree =  10,000; // 7 nodes 14s
                 // const V max_degree =   1,000; //   nodes 16s
                 // const V max_degree =     100; //   nodes 20s
-                while (degree.get<DegreeTag>().begin()->second > max_degree) {
-                    const N n = degree.get<DegreeTag>().begin()->first; // this is the node with highest degree. Delete one of its edges
-                    const V current_degree = degree.get<DegreeTag>().begin()->second;
+                while (degree.template get<DegreeTag>().begin()->second > max_degree) {
+                    const N n = degree.template get<DegreeTag>().begin()->first; // this is the node with highest degree. Delete one of its edges
+                    const V current_degree = degree.template get<DegreeTag>().begin()->second;
                     // cout << '\"' << n << '\"' << "\tdegree" << current_degree << endl;
                     typename set<pair<N, N> >::iterator i;
                     i = edges.lower_bound(make_pair(n, N()));
@@ -247,9 +247,9 @@ namespace graph_loading {
                             if (i != edges.end() && i->first != n)
                                 i = edges.end(); // just in case the next line screws up the iterators
                             edges.erase(make_pair(delete_this, n));
-                            degree.get<NameTag>().modify(degree.get<NameTag>().find(delete_this),
+                            degree.template get<NameTag>().modify(degree.template get<NameTag>().find(delete_this),
                                                          DegreeDecrementer<Name>);
-                            degree.get<NameTag>().modify(degree.get<NameTag>().find(n), DegreeDecrementer<Name>);
+                            degree.template get<NameTag>().modify(degree.template get<NameTag>().find(n), DegreeDecrementer<Name>);
                         } else {
                             to_survive--;
                             i++;
@@ -266,7 +266,7 @@ namespace graph_loading {
                     //cout << '\"' << n << '\"' << '\t' << current_degree << '\t' << deleted_from_me << '\t' << current_degree - deleted_from_me << endl;
                     // TODO: what if this leaves a node with degree zero in names?
                 }
-                PP(degree.get<DegreeTag>().begin()->second);
+                PP(degree.template get<DegreeTag>().begin()->second);
             }
 
             bg.edge_count = edges.size();
@@ -274,7 +274,7 @@ namespace graph_loading {
         }
         {
             ForeachContainer(const N &n, *names) {
-                        if (degree.get<NameTag>().find(n)->second > 0)
+                        if (degree.template get<NameTag>().find(n)->second > 0)
                             bg.vertex_mappings.push_back(n);
                     }
             free(names);
@@ -298,8 +298,8 @@ namespace graph_loading {
                     edge++;
                 }
                 bg.degrees.push_back(my_degree);
-                DYINGWORDS (degree.get<NameTag>().find(n)->second == my_degree) {
-                    PP (degree.get<NameTag>().find(n)->second);
+                DYINGWORDS (degree.template get<NameTag>().find(n)->second == my_degree) {
+                    PP (degree.template get<NameTag>().find(n)->second);
                     PP (my_degree);
                 }
                 bg.offsets.push_back(offset);
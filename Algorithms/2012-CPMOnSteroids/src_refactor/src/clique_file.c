@@ -0,0 +1,254 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "clique_file.h"
+
+static size_t clique_file_size(uint32_t k_max, uint64_t num_cliques, uint64_t num_entries) {
+  return sizeof(clique_file_header) + sizeof(uint64_t) * (k_max + 1) +
+    sizeof(uint64_t) * (num_cliques + 1) + sizeof(int32_t) * num_entries;
+}
+
+static int compare_nodes(const void *a, const void *b) {
+  int32_t node_a = *(const int32_t*)a, node_b = *(const int32_t*)b;
+  return (node_a > node_b) - (node_a < node_b);
+}
+
+/*
+ * read the next clique of the text file into *nodes, growing it if needed.
+ * A clique ends with a negative node (the -1 of the COS format) or with the
+ * end of the line, so an empty clique is read after a -1 at the end of a line.
+ * Returns 0 when the end of the file has been reached, -1 if *nodes could not
+ * be grown, 1 otherwise
+ */
+static int read_clique(FILE *input, int32_t **nodes, size_t *capacity, size_t *size) {
+  int ch, value = 0, digits = 0, negative = 0;
+  int32_t *grown;
+  *size = 0;
+  for (;;) {
+    ch = getc_unlocked(input);
+    if (ch >= '0' && ch <= '9') {
+      value = value * 10 + (ch - '0');
+      digits = 1;
+      continue;
+    }
+    if (ch == '-' && !digits) {
+      negative = 1;
+      continue;
+    }
+    if (digits) {
+      if (negative)
+        return 1;
+      if (*size == *capacity) {
+        if ((grown = (int32_t*)realloc(*nodes, sizeof(int32_t) * (*capacity ? *capacity * 2 : 64))) == NULL)
+          return -1;
+        *nodes = grown;
+        *capacity = *capacity ? *capacity * 2 : 64;
+      }
+      (*nodes)[(*size)++] = value;
+      value = 0;
+      digits = 0;
+    }
+    negative = 0;
+    if (ch == '\n')
+      return 1;
+    if (ch == EOF)
+      return *size > 0;
+  }
+}
+
+/*
+ * check that the tables of a mapped file agree with each other: the groups of
+ * k_counts cover all the cliques, every clique of a group has the size of the
+ * group, the last offset is num_entries and every node is below num_nodes.
+ * Returns 0 if they do
+ */
+static int clique_file_check(const clique_file *f) {
+  uint64_t i = 0, count, total = 0;
+  uint32_t k;
+
+  for (k = 0; k <= f->header->k_max; k++) {
+    if (k < 3 && f->k_counts[k] != 0)
+      return -1;
+    if (f->k_counts[k] > f->header->num_cliques - total)
+      return -1;
+    total += f->k_counts[k];
+  }
+  if (total != f->header->num_cliques || f->offsets[0] != 0)
+    return -1;
+  for (k = f->header->k_max; k >= 3; k--)
+    for (count = 0; count < f->k_counts[k]; count++, i++)
+      if (f->offsets[i] > f->header->num_entries || f->offsets[i+1] - f->offsets[i] != k)
+        return -1;
+  if (f->offsets[f->header->num_cliques] != f->header->num_entries)
+    return -1;
+  for (i = 0; i < f->header->num_entries; i++)
+    if (f->nodes[i] < 0 || (uint32_t)f->nodes[i] >= f->header->num_nodes)
+      return -1;
+  return 0;
+}
+
+int clique_file_is_binary(const char *path) {
+  char magic[8];
+  FILE *input;
+  int is_binary;
+  if ((input = fopen(path, "rb")) == NULL)
+    return 0;
+  is_binary = fread(magic, 1, sizeof(magic), input) == sizeof(magic) &&
+    memcmp(magic, CLIQUE_FILE_MAGIC, sizeof(magic)) == 0;
+  fclose(input);
+  return is_binary;
+}
+
+int clique_file_map(clique_file *f, const char *path) {
+  struct stat st;
+  const char *base;
+  int fd;
+
+  if (f == NULL || path == NULL)
+    return -1;
+  if ((fd = open(path, O_RDONLY)) < 0)
+    return -2;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(clique_file_header)) {
+    close(fd);
+    return -3;
+  }
+  f->map_size = st.st_size;
+  f->map = mmap(NULL, f->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (f->map == MAP_FAILED)
+    return -2;
+
+  base = (const char*)f->map;
+  f->header = (const clique_file_header*)base;
+  if (memcmp(f->header->magic, CLIQUE_FILE_MAGIC, sizeof(f->header->magic)) != 0 ||
+      f->header->num_cliques >= f->map_size / sizeof(uint64_t) ||
+      f->header->num_entries >= f->map_size / sizeof(int32_t) ||
+      f->header->k_max >= f->map_size / sizeof(uint64_t) ||
+      f->map_size != clique_file_size(f->header->k_max, f->header->num_cliques, f->header->num_entries)) {
+    clique_file_unmap(f);
+    return -3;
+  }
+  f->k_counts = (const uint64_t*)(base + sizeof(clique_file_header));
+  f->offsets = f->k_counts + f->header->k_max + 1;
+  f->nodes = (const int32_t*)(f->offsets + f->header->num_cliques + 1);
+  if (clique_file_check(f) != 0) {
+    clique_file_unmap(f);
+    return -3;
+  }
+  return 0;
+}
+
+int clique_file_unmap(clique_file *f) {
+  if (f == NULL || f->map == NULL)
+    return -1;
+  munmap(f->map, f->map_size);
+  f->map = NULL;
+  return 0;
+}
+
+/*
+ * release everything clique_file_convert holds and return result, so that
+ * every exit of the conversion goes through the same cleanup
+ */
+static int convert_finish(FILE *input, char *base, size_t map_size, int32_t *nodes,
+                          uint64_t *k_counts, uint64_t *next, int result) {
+  if (input != NULL)
+    fclose(input);
+  if (base != NULL)
+    munmap(base, map_size);
+  free(nodes);
+  free(k_counts);
+  free(next);
+  return result;
+}
+
+int clique_file_convert(const char *text_path, const char *binary_path) {
+  FILE *input;
+  int32_t *nodes = NULL;
+  size_t capacity = 0, size, n, i;
+  uint64_t *k_counts = NULL, *next = NULL, *offsets, *grown;
+  uint64_t num_cliques = 0, num_entries = 0, entry;
+  uint32_t k_max = 0, k;
+  int32_t max_node = -1;
+  clique_file_header *header;
+  char *base = NULL;
+  size_t map_size = 0;
+  int fd, read;
+
+  if (text_path == NULL || binary_path == NULL)
+    return -1;
+  if ((input = fopen(text_path, "r")) == NULL)
+    return -2;
+
+  // first pass: count the cliques of each size
+  while ((read = read_clique(input, &nodes, &capacity, &size)) > 0) {
+    if (size < 3)
+      continue;
+    if (size > k_max) {
+      if ((grown = (uint64_t*)realloc(k_counts, sizeof(uint64_t) * (size + 1))) == NULL)
+        return convert_finish(input, base, map_size, nodes, k_counts, next, -4);
+      k_counts = grown;
+      memset(k_counts + (k_max ? k_max + 1 : 0), 0, sizeof(uint64_t) * (size + 1 - (k_max ? k_max + 1 : 0)));
+      k_max = size;
+    }
+    k_counts[size]++;
+    num_cliques++;
+    num_entries += size;
+    for (n = 0; n < size; n++)
+      if (nodes[n] > max_node)
+        max_node = nodes[n];
+  }
+  if (read < 0)
+    return convert_finish(input, base, map_size, nodes, k_counts, next, -4);
+
+  // the cliques of each size start where the larger ones end, and all the
+  // cliques of a group have the same size
+  if ((next = (uint64_t*)malloc(sizeof(uint64_t) * (k_max + 1))) == NULL)
+    return convert_finish(input, base, map_size, nodes, k_counts, next, -4);
+
+  map_size = clique_file_size(k_max, num_cliques, num_entries);
+  if ((fd = open(binary_path, O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0)
+    return convert_finish(input, base, map_size, nodes, k_counts, next, -2);
+  if (ftruncate(fd, map_size) != 0 ||
+      (base = (char*)mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+    close(fd);
+    base = NULL;
+    return convert_finish(input, base, map_size, nodes, k_counts, next, -3);
+  }
+  close(fd);
+
+  header = (clique_file_header*)base;
+  memcpy(header->magic, CLIQUE_FILE_MAGIC, sizeof(header->magic));
+  header->k_max = k_max;
+  header->num_nodes = max_node + 1;
+  header->num_cliques = num_cliques;
+  header->num_entries = num_entries;
+  offsets = (uint64_t*)(base + sizeof(clique_file_header)) + k_max + 1;
+  if (k_max > 0)
+    memcpy(offsets - (k_max + 1), k_counts, sizeof(uint64_t) * (k_max + 1));
+  else
+    offsets[-1] = 0;
+
+  i = 0;
+  entry = 0;
+  for (k = k_max; k >= 3; k--) {
+    next[k] = i;
+    for (n = 0; n < k_counts[k]; n++, i++, entry += k)
+      offsets[i] = entry;
+  }
+  offsets[num_cliques] = num_entries;
+
+  // second pass: store each clique, sorted, in the next place of its group
+  rewind(input);
+  while ((read = read_clique(input, &nodes, &capacity, &size)) > 0) {
+    if (size < 3)
+      continue;
+    qsort(nodes, size, sizeof(int32_t), compare_nodes);
+    memcpy((int32_t*)(offsets + num_cliques + 1) + offsets[next[size]++], nodes, sizeof(int32_t) * size);
+  }
+  return convert_finish(input, base, map_size, nodes, k_counts, next, read < 0 ? -4 : 0);
+}
@@ -0,0 +1,64 @@
+#ifndef CLIQUE_FILE_H
+#define CLIQUE_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Binary maximal cliques file, which can be mapped in memory and used without
+ * any parsing. All the integers are in the byte order of the machine that
+ * wrote the file:
+ *
+ *   clique_file_header
+ *   uint64_t k_counts[k_max+1]       number of maximal cliques with k nodes
+ *   uint64_t offsets[num_cliques+1]  clique i is nodes[offsets[i]] ... nodes[offsets[i+1]-1]
+ *   int32_t  nodes[num_entries]
+ *
+ * The cliques are grouped by size, from the largest to the smallest, and keep
+ * the order of the text file inside each group; the nodes of each clique are
+ * sorted. This is the order in which COS numbers the maximal cliques, so the
+ * cliques with at least k nodes are always the first ones. Cliques with less
+ * than 3 nodes are not stored.
+ */
+
+#define CLIQUE_FILE_MAGIC "MXCLQBIN"
+
+typedef struct clique_file_header {
+  char magic[8];
+  uint32_t k_max;        // number of nodes of the largest clique
+  uint32_t num_nodes;    // greatest node + 1
+  uint64_t num_cliques;
+  uint64_t num_entries;  // sum of the sizes of all the cliques
+} clique_file_header;
+
+typedef struct clique_file {
+  const clique_file_header *header;
+  const uint64_t *k_counts;
+  const uint64_t *offsets;
+  const int32_t *nodes;
+  void *map;
+  size_t map_size;
+} clique_file;
+
+/*
+ * returns 1 if the file at path starts with CLIQUE_FILE_MAGIC, 0 otherwise
+ */
+extern int clique_file_is_binary(const char *path);
+
+/*
+ * map the binary file at path read-only and set the pointers of f into it.
+ * The file is rejected, and nothing is left mapped, unless its size, k_counts,
+ * offsets and nodes all agree with the header
+ */
+extern int clique_file_map(clique_file *f, const char *path);
+extern int clique_file_unmap(clique_file *f);
+
+/*
+ * convert a text list of maximal cliques, where each clique is a whitespace
+ * separated list of non-negative nodes ending with -1 or with the end of the
+ * line, into a binary file. The text file is read twice and the cliques are
+ * never all kept in memory.
+ */
+extern int clique_file_convert(const char *text_path, const char *binary_path);
+
+#endif /* CLIQUE_FILE_H */
@@ -1,15 +1,25 @@
+#include <string.h>
 #include "cliques.h"
+#include "clique_file.h"
 #include "debug.h"
 
 static int cliques_count_maximal_cliques(cliques *c);
 static int cliques_order_cliques_by_decreasing_k(cliques *c, const char *path);
 static int cliques_init_member_vectors(cliques *c, int max_size);
+static int cliques_pack(cliques *c);
+static void cliques_destroy_member_vectors(cliques *c);
+static int cliques_index_nodes(cliques *c);
 
 int cliques_init(cliques **c) {
   if ((*c = (cliques*)malloc(sizeof(cliques))) == NULL)
     return -1;
   (*c)->maximal_cliques_total = 0;
   (*c)->k_max = 0;
+  (*c)->clique_nodes = NULL;
+  (*c)->clique_offsets = NULL;
+  (*c)->node_cliques = NULL;
+  (*c)->node_offsets = NULL;
+  (*c)->num_nodes = 0;
   return 0;
 }
 
@@ -39,8 +49,10 @@ int cliques_load_unordered_maximal_cliques_list(cliques *c, const char *path) {
 
     // initialize cliques structure internal vectors
     // according to the size of the maximum clique
-    if((cliques_init_member_vectors(c, max_size)) < 0)
+    if((cliques_init_member_vectors(c, max_size)) < 0) {
+      fclose(input);
       return -3;
+    }
 
     // reset the file position indicator to the beginning of the file
     fseek(input, 0L, SEEK_SET);
@@ -59,11 +71,60 @@ int cliques_load_unordered_maximal_cliques_list(cliques *c, const char *path) {
         igraph_vector_init(k_clique_v, 0);
       }
     }
+    fclose(input);
     cliques_order_cliques_by_decreasing_k(c, NULL);
     igraph_vector_destroy(k_clique_v);
+    free(k_clique_v);
+    if (cliques_pack(c) < 0)
+      return -4;
+    // from here on only the packed arrays are used
+    cliques_destroy_member_vectors(c);
+    if (cliques_index_nodes(c) < 0)
+      return -4;
     return 0;
 }
 
+/*
+ * Load the maximal cliques from a binary file written by clique_file_convert.
+ * The file is mapped in memory and its cliques are used where they are, only
+ * the inverted index of the nodes is built.
+ */
+int cliques_load_binary_maximal_cliques_list(cliques *c, const char *path) {
+  clique_file f;
+  unsigned int k;
+  if (c == NULL || path == NULL)
+    return -1;
+  if (clique_file_map(&f, path) != 0)
+    return -2;
+  if (f.header->k_max < 3) {
+    clique_file_unmap(&f);
+    return -3;
+  }
+
+  igraph_vector_init(&c->maximal_cliques_count_v, f.header->k_max + 1);
+  for (k = f.header->k_max; k >= 3; k--) {
+    if (f.k_counts[k] == 0)
+      continue;
+    printf("k: %i total: %li\n\n", k, (long int)f.k_counts[k]);
+    VECTOR(c->maximal_cliques_count_v)[k] = f.k_counts[k];
+    c->maximal_cliques_total += f.k_counts[k];
+    if (c->k_max == 0) c->k_max = k;
+  }
+  debug((DEBUG_NORMAL, "maximal_cliques_total %li", c->maximal_cliques_total));
+
+  // the mapping is read-only, nothing writes to the cliques
+  c->clique_nodes = (int*)f.nodes;
+  c->clique_offsets = (uint64_t*)f.offsets;
+  c->num_nodes = f.header->num_nodes;
+  if (cliques_index_nodes(c) < 0) {
+    c->clique_nodes = NULL;
+    c->clique_offsets = NULL;
+    clique_file_unmap(&f);
+    return -4;
+  }
+  return 0;
+}
+
 static int cliques_init_member_vectors(cliques *c, int max_size){
   igraph_vector_ptr_t *cur_v_ptr;
   int i;
@@ -150,6 +211,95 @@ static int cliques_order_cliques_by_decreasing_k(cliques *c, const char *path) {
     return 0;
 }
 
+/*
+ * Copy the ordered cliques into contiguous arrays.
+ */
+static int cliques_pack(cliques *c) {
+  unsigned long int i, n, total_nodes = 0;
+  igraph_vector_t *k_clique_v;
+
+  if (c == NULL)
+    return -1;
+  if ((c->clique_offsets = (uint64_t*)malloc(sizeof(uint64_t) * (c->maximal_cliques_total + 1))) == NULL)
+    return -2;
+  c->num_nodes = 0;
+  for (i = 0; i < c->maximal_cliques_total; i++) {
+    k_clique_v = (igraph_vector_t*)VECTOR(c->plain_cliques_v_ptr)[i];
+    c->clique_offsets[i] = total_nodes;
+    total_nodes += igraph_vector_size(k_clique_v);
+    if (igraph_vector_size(k_clique_v) > 0 && (int)igraph_vector_tail(k_clique_v) >= c->num_nodes)
+      c->num_nodes = (int)igraph_vector_tail(k_clique_v) + 1;
+  }
+  c->clique_offsets[c->maximal_cliques_total] = total_nodes;
+
+  if ((c->clique_nodes = (int*)malloc(sizeof(int) * (total_nodes + 1))) == NULL)
+    return -2;
+
+  // the vectors are sorted while loading
+  for (i = 0; i < c->maximal_cliques_total; i++) {
+    k_clique_v = (igraph_vector_t*)VECTOR(c->plain_cliques_v_ptr)[i];
+    for (n = c->clique_offsets[i]; n < c->clique_offsets[i+1]; n++)
+      c->clique_nodes[n] = (int)VECTOR(*k_clique_v)[n - c->clique_offsets[i]];
+  }
+  return 0;
+}
+
+/*
+ * Free the igraph vectors of the cliques once they are packed: every clique,
+ * the per-k lists and the ordered list, which holds the same vectors.
+ */
+static void cliques_destroy_member_vectors(cliques *c) {
+  unsigned long int i, k;
+  igraph_vector_ptr_t *maximal_k_cliques_v_ptr;
+  igraph_vector_t *k_clique_v;
+
+  for (k = 0; k < (unsigned long int)igraph_vector_ptr_size(&c->maximal_cliques_v_ptr); k++) {
+    maximal_k_cliques_v_ptr = (igraph_vector_ptr_t*)VECTOR(c->maximal_cliques_v_ptr)[k];
+    for (i = 0; i < (unsigned long int)igraph_vector_ptr_size(maximal_k_cliques_v_ptr); i++) {
+      k_clique_v = (igraph_vector_t*)VECTOR(*maximal_k_cliques_v_ptr)[i];
+      igraph_vector_destroy(k_clique_v);
+      free(k_clique_v);
+    }
+    igraph_vector_ptr_destroy(maximal_k_cliques_v_ptr);
+    free(maximal_k_cliques_v_ptr);
+  }
+  igraph_vector_ptr_destroy(&c->maximal_cliques_v_ptr);
+  igraph_vector_ptr_destroy(&c->plain_cliques_v_ptr);
+}
+
+/*
+ * Build the node -> cliques inverted index, so that the overlaps of a clique
+ * with all the following ones can be counted by visiting only the cliques
+ * which share a node with it.
+ */
+static int cliques_index_nodes(cliques *c) {
+  unsigned long int i, n, total_nodes;
+  unsigned long int *next;
+  int u;
+
+  if (c == NULL)
+    return -1;
+  total_nodes = c->clique_offsets[c->maximal_cliques_total];
+  c->node_cliques = (int*)malloc(sizeof(int) * (total_nodes + 1));
+  c->node_offsets = (unsigned long int*)calloc(c->num_nodes + 1, sizeof(unsigned long int));
+  next = (unsigned long int*)malloc(sizeof(unsigned long int) * (c->num_nodes + 1));
+  if (c->node_cliques == NULL || c->node_offsets == NULL || next == NULL)
+    return -2;
+
+  for (n = 0; n < total_nodes; n++)
+    c->node_offsets[c->clique_nodes[n]+1]++;
+  for (u = 0; u < c->num_nodes; u++) {
+    c->node_offsets[u+1] += c->node_offsets[u];
+    next[u] = c->node_offsets[u];
+  }
+  // cliques are visited in increasing order, so every list comes out sorted
+  for (i = 0; i < c->maximal_cliques_total; i++)
+    for (n = c->clique_offsets[i]; n < c->clique_offsets[i+1]; n++)
+      c->node_cliques[next[c->clique_nodes[n]]++] = (int)i;
+  free(next);
+  return 0;
+}
+
 int cliques_rows_to_be_read(const cliques *c, unsigned int k, unsigned long int *rows) {
     unsigned int i;
     *rows = 0;
@@ -161,44 +311,74 @@ int cliques_rows_to_be_read(const cliques *c, unsigned int k, unsigned long int
     return 0;
 }
 
-igraph_vector_t* cliques_get_clique(cliques* c, int i){
-  return igraph_vector_ptr_e(&(c->plain_cliques_v_ptr), i);
+const int* cliques_get_clique(cliques* c, int i){
+  return c->clique_nodes + c->clique_offsets[i];
 }
 
 uint8_t cliques_get_clique_size(cliques* c, int i){
-  igraph_vector_t* ptr = igraph_vector_ptr_e(&(c->plain_cliques_v_ptr), i);
-  return igraph_vector_size(ptr);
+  return c->clique_offsets[i+1] - c->clique_offsets[i];
 }
 
 uint8_t cliques_overlap_cliques(cliques* c, int i, int j){
-  igraph_vector_t *i_clique, *j_clique;
+  const int *i_node, *i_end, *j_node, *j_end;
   uint8_t overlap_size = 0;
-  int node_it;
-  int clique_size;
 
-  i_clique = (igraph_vector_t*)VECTOR(c->plain_cliques_v_ptr)[i];
-  j_clique = (igraph_vector_t*)VECTOR(c->plain_cliques_v_ptr)[j];
+  i_node = c->clique_nodes + c->clique_offsets[i];
+  i_end = c->clique_nodes + c->clique_offsets[i+1];
 
   if (i == j)
-    return igraph_vector_size(i_clique);
-  
-  if( (igraph_vector_tail(i_clique) >= VECTOR(*j_clique)[0]) && (VECTOR(*i_clique)[0] <= igraph_vector_tail(j_clique))){		
-    clique_size = igraph_vector_size(j_clique);
-    for (node_it = 0; node_it < clique_size; node_it++) {
-      if (VECTOR(*j_clique)[node_it] < VECTOR(*i_clique)[0])
-	// if the current node is lower than i_clique minimum node, then continue
-	continue;
-      if (VECTOR(*j_clique)[node_it] > igraph_vector_tail(i_clique))
-	// if the current node is greater than i_clique maximum node, than exit
-	break;
-      // search element node_it^th of j_clique within i_clique vector
-      if (igraph_vector_binsearch2(i_clique, VECTOR(*j_clique)[node_it]))
-	overlap_size++;
+    return i_end - i_node;
+
+  j_node = c->clique_nodes + c->clique_offsets[j];
+  j_end = c->clique_nodes + c->clique_offsets[j+1];
+
+  // merge the two sorted cliques
+  while (i_node < i_end && j_node < j_end) {
+    if (*i_node < *j_node)
+      i_node++;
+    else if (*j_node < *i_node)
+      j_node++;
+    else {
+      overlap_size++;
+      i_node++;
+      j_node++;
     }
   }
   return overlap_size;
 }
 
+/*
+ * Write the overlap of clique i with every clique j > i into row[j-i-1].
+ * Only the cliques which share at least a node with clique i are visited: for
+ * each node of clique i, the cliques after i in its inverted index list get
+ * one more shared node.
+ */
+int cliques_overlap_row(const cliques* c, int i, uint8_t *row){
+  unsigned long int n;
+  const int *first, *last, *middle;
+
+  if (c == NULL || row == NULL)
+    return -1;
+  memset(row, 0, c->maximal_cliques_total - i - 1);
+
+  for (n = c->clique_offsets[i]; n < c->clique_offsets[i+1]; n++) {
+    first = c->node_cliques + c->node_offsets[c->clique_nodes[n]];
+    last = c->node_cliques + c->node_offsets[c->clique_nodes[n] + 1];
+    // skip the cliques up to i (binary search for the first one after i)
+    while (first < last) {
+      middle = first + (last - first) / 2;
+      if (*middle <= i)
+        first = middle + 1;
+      else
+        last = middle;
+    }
+    last = c->node_cliques + c->node_offsets[c->clique_nodes[n] + 1];
+    for (; first < last; first++)
+      row[*first - i - 1]++;
+  }
+  return 0;
+}
+
 /*
 cliques* load_cliques(){
 
@@ -13,20 +13,34 @@ struct cliques{
   //  long int num_cliques;
   //  int max_k;
 
+  // only used while a text list is loaded, destroyed once the cliques are packed
   igraph_vector_ptr_t maximal_cliques_v_ptr;
   igraph_vector_ptr_t plain_cliques_v_ptr;
   igraph_vector_t maximal_cliques_count_v;
   unsigned long int maximal_cliques_total;
   unsigned int k_max;
+
+  // the cliques ordered by decreasing k packed one after the other, each sorted:
+  // clique i is clique_nodes[clique_offsets[i]] ... clique_nodes[clique_offsets[i+1]-1].
+  // When the cliques are loaded from a binary file these point into its mapping
+  int *clique_nodes;
+  uint64_t *clique_offsets;
+  // inverted index: the cliques containing node u, in increasing order, are
+  // node_cliques[node_offsets[u]] ... node_cliques[node_offsets[u+1]-1]
+  int *node_cliques;
+  unsigned long int *node_offsets;
+  int num_nodes;
 };
 typedef struct cliques cliques;
 
 extern int cliques_init(cliques **c);
 extern int cliques_load_unordered_maximal_cliques_list(cliques *c, const char *path);
+extern int cliques_load_binary_maximal_cliques_list(cliques *c, const char *path);
 extern int cliques_rows_to_be_read(const cliques *c, unsigned int k, unsigned long int *rows);
-extern igraph_vector_t* cliques_get_clique(cliques* c, int i);
+extern const int* cliques_get_clique(cliques* c, int i);
 extern uint8_t cliques_get_clique_size(cliques* c, int i);
 extern uint8_t cliques_overlap_cliques(cliques* c, int i, int j);
+extern int cliques_overlap_row(const cliques* c, int i, uint8_t *row);
 
 #endif	/* CLIQUES_H */
 
@@ -10,7 +10,6 @@ struct constructor_thread_data {
 typedef struct constructor_thread_data constructor_thread_data;
 
 struct community_thread_data {
-  dsforest_t *thread_dsf;
   int start_from_row;
 };
 
@@ -7,77 +7,37 @@
 
 extern cliques *all_cliques;
 extern int k_max;
-extern dsforest_t **global_dsf;
-extern pthread_mutex_t *global_dsf_mutexes;
+extern dsforest_t *global_dsf;
 extern int NUM_THREADS;
 extern unsigned long int WINDOW_SIZE;
 
 static matrix *m;
+static pthread_barrier_t level_barrier;
 
 static void constructor_thread_body(void* params){
-  uint8_t overlap_value;
+  uint8_t *row;
   struct constructor_thread_data* ctd = (struct constructor_thread_data*) params;
   int i = ctd->start_from_row;		// row iterator
-  int j = 0;				// column itearator
-  int counter = 0;
 
+  // the whole row is filled at once from the inverted index of the cliques
   for (; matrix_row_in_window(m,i) == TRUE; i+=NUM_THREADS) {
-    for ( j = i+1; j < all_cliques->maximal_cliques_total ; j++) {
-      overlap_value =  cliques_overlap_cliques(all_cliques, i, j);
-      matrix_set(m, i, j, overlap_value);
-      counter++;	
-    }
+    matrix_get_row(m, i, &row);
+    cliques_overlap_row(all_cliques, i, row);
   }
   pthread_exit(NULL);
 }
 
-static int community_thread_epilogue(dsforest_t *thread_dsf, unsigned int k, unsigned long int rows_to_be_read){
-  int i;
-  int root_i, global_dsf_root_i, global_dsf_root_root_i;
-
-  pthread_mutex_lock(&global_dsf_mutexes[k-3]);
-  /*
-    BEGIN OF CRITICAL SECTION
-  */
-  for(i=0; i < rows_to_be_read; i++){
-    root_i = dsforest_find(thread_dsf, i);
-    if(i == root_i)
-      // there is no need to go further since i is the root
-      // of a disjoint set
-      continue;
-    // INVARIANT: i and root_i must belong to the same disjoint set (i.e. the same connected
-    // component) in the k-th global disjoint sets forest: gloabal_dsf[k]
-    global_dsf_root_i = dsforest_find(global_dsf[k-3], i);
-    global_dsf_root_root_i = dsforest_find(global_dsf[k-3], root_i);
-    if(global_dsf_root_i == global_dsf_root_root_i)
-      // they are yet in the same set
-      continue;
-    // merge the two components in the global disjoint set forests:
-    // these components contains i and root_i respectively
-    dsforest_union(global_dsf[k-3], global_dsf_root_i, global_dsf_root_root_i);
-  }
-  pthread_mutex_unlock(&global_dsf_mutexes[k-3]);
-  /*
-    END OF CRITICAL SECTION
-  */
-  return 0;
-}
-
 static void community_thread_body(void* params){
-  int root_i, root_j;
   // matrix iterators
   int i=-1,j;
   int k;
   uint8_t overlapping_value;
   unsigned long int rows_to_be_read;
-  dsforest_t *thread_dsf;
 
   // cast the void* pointer to the struct used for passing us our parameters
   // and get them
   struct community_thread_data* ctdata = (struct community_thread_data*) params;
 
-  dsforest_init(&thread_dsf, all_cliques->maximal_cliques_total);
-
   for(k=k_max; k >= 3; k--){
     // get the first index in the window
     i = ctdata->start_from_row;
@@ -87,7 +47,6 @@ static void community_thread_body(void* params){
       continue;
 
     for (;matrix_row_in_window(m,i) == TRUE && i < rows_to_be_read; i+=NUM_THREADS) {
-      root_i = dsforest_find(thread_dsf, i);
       j = i+1;
       for (; j < rows_to_be_read; j++) {
 	// overlapping
@@ -99,28 +58,40 @@ static void community_thread_body(void* params){
 	if (overlapping_value < k-1)
 	  continue;
 
+	// the pair is only merged in the forest of the greatest k it belongs to,
+	// community_level_thread_body carries the merge to the smaller k
 	overlapping_value=0;
 	if(matrix_set(m, i, j, overlapping_value) != 0){
 	  printf("Error writing the matrix\n");
 	  pthread_exit(NULL);
-	}	
-
-	root_j = dsforest_find(thread_dsf, j);
-
-	if(root_i != root_j){
-	  // since after the union the root node of i, i.e. i_root, could be changed
-	  // we must verify if it has become a non-root node and update it accordingly.
-	  // i_root can change if it has been linked as son of j_root because of
-	  // a smaller rank
-	  dsforest_union(thread_dsf, root_i, root_j);
-	  if(!dsforest_is_root(thread_dsf, root_i))
-	    root_i = dsforest_find(thread_dsf, i);
 	}
+
+	// the forest is shared by all threads, no lock is needed
+	dsforest_union(global_dsf, k-3, i, j);
       }
     }
-    community_thread_epilogue(thread_dsf, k, rows_to_be_read);
   }
-  dsforest_destroy(thread_dsf);
+  pthread_exit(NULL);
+}
+
+/*
+ * every (k+1)-clique community is contained in a k-clique community: once the
+ * whole matrix has been read, the sets of the forest of each k are merged into
+ * the forest of k-1, from k_max down to 4. The threads share the rows of each k
+ * and wait for each other before going to the next one.
+ */
+static void community_level_thread_body(void* params){
+  struct community_thread_data* ctdata = (struct community_thread_data*) params;
+  unsigned long int i, rows_to_be_read;
+  int k;
+
+  for(k=k_max; k > 3; k--){
+    cliques_rows_to_be_read(all_cliques, k, &rows_to_be_read);
+    for(i=ctdata->start_from_row; i < rows_to_be_read; i+=NUM_THREADS)
+      if(!dsforest_is_root(global_dsf, k-3, i))
+	dsforest_union(global_dsf, k-4, i, dsforest_find(global_dsf, k-3, i));
+    pthread_barrier_wait(&level_barrier);
+  }
   pthread_exit(NULL);
 }
 
@@ -174,30 +145,15 @@ int cos_() {
 	
   comm_thread_data = (community_thread_data*) malloc(sizeof(community_thread_data) * NUM_THREADS);	
   for (i = 0; i < NUM_THREADS; i++) {
-    // initialize a disjoint set forest specific to each thread. It will use that forest
-    // for processing the overlap between maximal cliques of every k and hence it must
-    // be of maximum size
     comm_thread_data[i].start_from_row = i;
   }	
 
   /***********************************************************************
    Initialization of communities structure
   ***********************************************************************/
-  // allocate global disjoint set forests for each k between 3 and k_max
-  global_dsf = (dsforest_t**)malloc(sizeof(dsforest_t*) * (k_max - 2));
-
-  // allocate space for the mutexes that will assure mutual exclusion
-  // while accessing global_dsf and communities_done
-  global_dsf_mutexes = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t) * (k_max - 2));
-
-  for (i = 0; i < (k_max - 2); i++) {
-    // compute the numer of maximal cliques which belong to at least one community
-    // this number is used for allocating the right number of independent set
-    // data structures. Recall that thread i will compute (i+3)-clique communities
-    unsigned long int disjoint_sets_number;
-    cliques_rows_to_be_read(all_cliques, i+3, &disjoint_sets_number);
-    dsforest_init(&global_dsf[i], disjoint_sets_number);
-    pthread_mutex_init(&global_dsf_mutexes[i], NULL);
+  if (init_found_communities() != 0) {
+    printf("ERROR in dsforest_init()!\n");
+    return -1;
   }
 
   int chunk = 0;			// chunk counter
@@ -284,16 +240,32 @@ int cos_() {
 
   printf("Done processing matrix chunks...\n");
 
+  // carry the communities of each k to the smaller ones
+  comm_threads = (pthread_t*) malloc(sizeof(pthread_t) * NUM_THREADS);
+  pthread_barrier_init(&level_barrier, NULL, NUM_THREADS);
+  for (i = 0; i < NUM_THREADS; i++) {
+    comm_thread_data[i].start_from_row = i;
+    thread_flag = pthread_create(&comm_threads[i], &attr, (void*)(&community_level_thread_body), (void*)(&comm_thread_data[i]));
+    if (thread_flag != 0) {
+      printf("pthread_create ERROR!\n");
+      return -1;
+    }
+  }
+  for (i = 0; i < NUM_THREADS; i++) {
+    thread_flag = pthread_join(comm_threads[i],&status);
+    if (thread_flag != 0) {
+      printf("pthread_join ERROR!\n");
+      return -1;
+    }
+  }
+  pthread_barrier_destroy(&level_barrier);
+  free(comm_threads);
+
   // write out found communities
   write_found_communities_to_file();
 
   // deallocate memory used for disjoint set forests
-  for(i=0; i < (k_max - 2); i++){
-    dsforest_destroy(global_dsf[i]);
-    pthread_mutex_destroy(&global_dsf_mutexes[i]);
-  }
-  free(global_dsf);
-  free(global_dsf_mutexes);
+  dsforest_destroy(global_dsf);
 
   // DEALLOCATING MEMORY for thread parameters
   free(const_thread_data);
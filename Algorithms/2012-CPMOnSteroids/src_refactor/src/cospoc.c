@@ -7,63 +7,15 @@
 
 extern cliques *all_cliques;
 extern int k_max;
-extern dsforest_t **global_dsf;
-extern pthread_mutex_t *global_dsf_mutexes;
+extern dsforest_t *global_dsf;
 extern int NUM_THREADS;
 
-static int cospoc_thread_epilogue(dsforest_t **thread_dsfs){
-  int i,k;
-  int root_i, global_dsf_root_i, global_dsf_root_root_i;
-  unsigned long int rows_to_be_read;
-
-  for(k=3; k<= k_max; k++){
-    cliques_rows_to_be_read(all_cliques, k, &rows_to_be_read);
-
-    pthread_mutex_lock(&global_dsf_mutexes[k-3]);
-    /*
-      BEGIN OF CRITICAL SECTION
-    */
-    for(i=0; i < rows_to_be_read; i++){
-      root_i = dsforest_find(thread_dsfs[k-3], i);
-      if(i == root_i)
-	// there is no need to go further since i is the root
-	// of a disjoint set
-	continue;
-      // INVARIANT: i and root_i must belong to the same disjoint set (i.e. the same connected
-      // component) in the k-th global disjoint sets forest: gloabal_dsf[k]
-      global_dsf_root_i = dsforest_find(global_dsf[k-3], i);
-      global_dsf_root_root_i = dsforest_find(global_dsf[k-3], root_i);
-      if(global_dsf_root_i == global_dsf_root_root_i)
-	// they are yet in the same set
-	continue;
-      // merge the two components in the global disjoint set forests:
-      // these components contains i and root_i respectively
-      dsforest_union(global_dsf[k-3], global_dsf_root_i, global_dsf_root_root_i);
-    }
-
-    pthread_mutex_unlock(&global_dsf_mutexes[k-3]);
-    /*
-      END OF CRITICAL SECTION
-    */
-  }
-  return 0;
-}
-
 static void cospoc_thread_body(void* params){
   int *overlaps;
   struct constructor_thread_data* ctd = (struct constructor_thread_data*) params;
   int i = ctd->start_from_row;		// row iterator
   int j = 0;				// column itearator
-  int root_i, root_j;
   int k;
-  dsforest_t **thread_dsfs;
-
-  thread_dsfs = (dsforest_t**)malloc(sizeof(dsforest_t*) * (k_max - 2));
-  for(k=3; k<=k_max; k++){
-    unsigned long int disjoint_sets_number;
-    cliques_rows_to_be_read(all_cliques, k, &disjoint_sets_number);
-    dsforest_init(&thread_dsfs[k-3], disjoint_sets_number);
-  }
 
   overlaps = (int*)malloc(sizeof(int) * all_cliques->maximal_cliques_total);
 
@@ -86,8 +38,6 @@ static void cospoc_thread_body(void* params){
       if(i >= rows_to_be_read)
 	continue;
 
-      root_i = dsforest_find(thread_dsfs[k-3], i);
-
       for ( j = i+1; j < rows_to_be_read; j++){
 
 	if(j >= j_old)
@@ -96,29 +46,12 @@ static void cospoc_thread_body(void* params){
 	if (overlaps[j] < k-1)
 	  continue;
 
-	root_j = dsforest_find(thread_dsfs[k-3], j);
-
-	if(root_i != root_j){
-	  // since after the union the root node of i, i.e. i_root, could be changed
-	  // we must verify if it has become a non-root node and update it accordingly.
-	  // i_root can change if it has been linked as son of j_root because of
-	  // a smaller rank
-	  dsforest_union(thread_dsfs[k-3], root_i, root_j);
-
-	  if(!dsforest_is_root(thread_dsfs[k-3], root_i))
-	    root_i = dsforest_find(thread_dsfs[k-3], i);
-
-	}
+	// the forest is shared by all threads, no lock is needed
+	dsforest_union(global_dsf, k-3, i, j);
       }
       j_old = j;
     }
   }
-  cospoc_thread_epilogue(thread_dsfs);
-
-  for(k=3; k<=k_max; k++)
-    dsforest_destroy(thread_dsfs[k-3]);
-
-  free(thread_dsfs);
   free(overlaps);
 
   pthread_exit(NULL);
@@ -153,21 +86,9 @@ int cospoc() {
   /***********************************************************************
    Initialization of communities structure
   ***********************************************************************/
-  // allocate global disjoint set forests for each k between 3 and k_max
-  global_dsf = (dsforest_t**)malloc(sizeof(dsforest_t*) * (k_max - 2));
-
-  // allocate space for the mutexes that will assure mutual exclusion
-  // while accessing global_dsf and communities_done
-  global_dsf_mutexes = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t) * (k_max - 2));
-
-  for (i = 0; i < (k_max - 2); i++) {
-    // compute the numer of maximal cliques which belong to at least one community
-    // this number is used for allocating the right number of independent set
-    // data structures. Recall that thread i will compute (i+3)-clique communities
-    unsigned long int disjoint_sets_number;
-    cliques_rows_to_be_read(all_cliques, i+3, &disjoint_sets_number);
-    dsforest_init(&global_dsf[i], disjoint_sets_number);
-    pthread_mutex_init(&global_dsf_mutexes[i], NULL);
+  if (init_found_communities() != 0) {
+    printf("ERROR in dsforest_init()!\n");
+    return -1;
   }
   /****************************************************************
      create NUM_THREADS threads which are able to read all_cliques
@@ -198,12 +119,7 @@ int cospoc() {
   write_found_communities_to_file();
 
   // deallocate memory used for disjoint set forests
-  for(i=0; i < (k_max - 2); i++){
-    dsforest_destroy(global_dsf[i]);
-    pthread_mutex_destroy(&global_dsf_mutexes[i]);
-  }
-  free(global_dsf);
-  free(global_dsf_mutexes);
+  dsforest_destroy(global_dsf);
 
   // DEALLOCATING MEMORY for thread parameters
   free(cospoc_thread_data);
@@ -1,95 +1,95 @@
 #include "dsforest.h"
 
-static int clear_node(forest_node_t* node){
-  node->comm_id = NO_COMMUNITY_ID_YET;
-  node->parent = NULL;
-  node->rank = 0;  
-  return 0;
-}
-
-static forest_node_t* make_set(int label) {
-  forest_node_t* node = (forest_node_t*)malloc(sizeof(forest_node_t));
-  clear_node(node);
-  node->label = label;
-  return node;
+static inline int load_parent(const int *parents, int x) {
+  return __atomic_load_n(&parents[x], __ATOMIC_ACQUIRE);
 }
 
-static forest_node_t* find(forest_node_t* node) {
-  forest_node_t *root;
-  if(node->parent==NULL)
-    // we have a root node
-    return node;
-  root = find(node->parent);
-  node->parent = root;
-  return root;
-}
-
-static int union_(forest_node_t* node1, forest_node_t* node2) {
-  if (node1->rank > node2->rank) {
-    node2->parent = node1;
-  } else if (node2->rank > node1->rank) {
-    node1->parent = node2;
-  } else { /* they are equal */
-    node2->parent = node1;
-    node1->rank++;
+static int find(int *parents, int x) {
+  int parent, grandparent;
+  while ((parent = load_parent(parents, x)) != x) {
+    grandparent = load_parent(parents, parent);
+    // path halving: if another thread changed the parent of x in the meantime
+    // the swap fails, which is fine since parents only move towards the root
+    if (parent != grandparent)
+      __atomic_compare_exchange_n(&parents[x], &parent, grandparent, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    x = grandparent;
   }
-  return 0;
+  return x;
 }
 
-extern int dsforest_init(dsforest_t **dsf, unsigned int num_elements){
-  int i;
+extern int dsforest_init(dsforest_t **dsf, unsigned int num_levels, const unsigned long int *level_sizes){
+  unsigned int level;
   if ((*dsf = (dsforest_t*)malloc(sizeof(dsforest_t))) == NULL)
     return -1;
-  if (((*dsf)->elements = (forest_node_t**)malloc(sizeof(forest_node_t*)*num_elements)) == NULL)
+  if (((*dsf)->level_offsets = (unsigned long int*)malloc(sizeof(unsigned long int)*(num_levels + 1))) == NULL)
     return -2;
-  (*dsf)->num_elements = num_elements;
-  for(i=0; i<num_elements; i++)
-    (*dsf)->elements[i] = make_set(i);
-  return 0;
+  (*dsf)->num_levels = num_levels;
+  (*dsf)->level_offsets[0] = 0;
+  for(level=0; level<num_levels; level++)
+    (*dsf)->level_offsets[level+1] = (*dsf)->level_offsets[level] + level_sizes[level];
+  if (((*dsf)->parents = (int*)malloc(sizeof(int)*((*dsf)->level_offsets[num_levels] + 1))) == NULL)
+    return -2;
+  return dsforest_clear(*dsf);
 }
 
 extern int dsforest_clear(dsforest_t *dsf){
-  int i;
-  for(i=0; i<dsf->num_elements; i++)
-    clear_node(dsf->elements[i]);
+  unsigned int level;
+  unsigned long int i;
+  // labels are local to the level, each element is the root of its own set
+  for(level=0; level<dsf->num_levels; level++)
+    for(i=0; i<dsforest_level_size(dsf, level); i++)
+      dsf->parents[dsf->level_offsets[level] + i] = i;
   return 0;
 }
 
 extern int dsforest_destroy(dsforest_t *dsf){
-  int i;
-  for(i=0; i<dsf->num_elements; i++)
-    free(dsf->elements[i]);
-  free(dsf->elements);
+  free(dsf->parents);
+  free(dsf->level_offsets);
   free(dsf);
   return 0;
 }
 
-extern int dsforest_find(dsforest_t *dsf, unsigned int node_label){
-  forest_node_t *node_ptr, *node_root_ptr;  
-  if(node_label >= dsf->num_elements)
+extern unsigned long int dsforest_level_size(const dsforest_t *dsf, unsigned int level){
+  return dsf->level_offsets[level+1] - dsf->level_offsets[level];
+}
+
+extern int dsforest_find(dsforest_t *dsf, unsigned int level, unsigned int node_label){
+  if(level >= dsf->num_levels || node_label >= dsforest_level_size(dsf, level))
     return -1;
-  // get the pointer to the node with label node_label which is located
-  // in the node_label-th entry of the array dsf->elements
-  node_ptr = dsf->elements[node_label];
-  node_root_ptr = find(node_ptr);
-  return node_root_ptr->label;
+  return find(dsf->parents + dsf->level_offsets[level], node_label);
 }
 
-extern int dsforest_union(dsforest_t *dsf, unsigned int root1_label, unsigned int root2_label) {
-  forest_node_t *r1_ptr,*r2_ptr;
-  if(root1_label >= dsf->num_elements || root2_label >= dsf->num_elements)
+/*
+ * merge the sets containing label1 and label2, which do not need to be roots.
+ * Returns 1 if two sets have been merged, 0 if they were already the same set
+ */
+extern int dsforest_union(dsforest_t *dsf, unsigned int level, unsigned int label1, unsigned int label2) {
+  int *parents;
+  int root1, root2, tmp;
+  if(level >= dsf->num_levels || label1 >= dsforest_level_size(dsf, level) || label2 >= dsforest_level_size(dsf, level))
     return -1;
-  // get the pointers to the nodes with the right labels
-  r1_ptr = dsf->elements[root1_label];
-  r2_ptr = dsf->elements[root2_label];
-  // they must be root nodes
-  if (r1_ptr->parent != NULL || r2_ptr->parent != NULL){
-    printf("HERE\n");
-    return -2;
+  parents = dsf->parents + dsf->level_offsets[level];
+  root1 = label1;
+  root2 = label2;
+  for(;;) {
+    root1 = find(parents, root1);
+    root2 = find(parents, root2);
+    if (root1 == root2)
+      return 0;
+    // link the greater root under the smaller one, so that parents always
+    // have smaller labels than their children and no cycle can be made
+    if (root1 < root2) {
+      tmp = root1;
+      root1 = root2;
+      root2 = tmp;
+    }
+    tmp = root1;
+    // fails if root1 has been linked by another thread: search again
+    if (__atomic_compare_exchange_n(&parents[root1], &tmp, root2, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      return 1;
   }
-  return union_(r1_ptr, r2_ptr);
 }
 
-extern int dsforest_is_root(dsforest_t *dsf, unsigned int label){
-  return (dsf->elements[label]->parent==NULL) ? 1 : 0;
+extern int dsforest_is_root(dsforest_t *dsf, unsigned int level, unsigned int label){
+  return (load_parent(dsf->parents + dsf->level_offsets[level], label) == (int)label) ? 1 : 0;
 }
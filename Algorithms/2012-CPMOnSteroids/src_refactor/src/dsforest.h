@@ -6,23 +6,25 @@
 
 #define NO_COMMUNITY_ID_YET   -1
 
-typedef struct forest_node {
-  int label;
-  int comm_id;
-  struct forest_node* parent;
-  int rank;
-}forest_node_t;
-
+/*
+ * Disjoint sets forests, one for each level (i.e. for each k), stored one
+ * after the other in a single array of parent labels. Every thread can call
+ * dsforest_find and dsforest_union at the same time without any lock: a root
+ * is linked under another one with a compare-and-swap, always under the root
+ * with the smaller label, and finds halve the paths they walk through.
+ */
 typedef struct dsforest {
-  unsigned int num_elements;
-  forest_node_t** elements;
+  unsigned int num_levels;
+  unsigned long int *level_offsets; // num_levels + 1 entries
+  int *parents;
 }dsforest_t;
 
-extern int dsforest_init(dsforest_t **dsf, unsigned int num_elements);
+extern int dsforest_init(dsforest_t **dsf, unsigned int num_levels, const unsigned long int *level_sizes);
 extern int dsforest_clear(dsforest_t *dsf);
 extern int dsforest_destroy(dsforest_t *dsf);
-extern int dsforest_union(dsforest_t *dsf, unsigned int root1_label, unsigned int root2_label);
-extern int dsforest_find(dsforest_t *dsf, unsigned int node_label);
-extern int dsforest_is_root(dsforest_t *dsf, unsigned int label);
+extern int dsforest_union(dsforest_t *dsf, unsigned int level, unsigned int label1, unsigned int label2);
+extern int dsforest_find(dsforest_t *dsf, unsigned int level, unsigned int node_label);
+extern int dsforest_is_root(dsforest_t *dsf, unsigned int level, unsigned int label);
+extern unsigned long int dsforest_level_size(const dsforest_t *dsf, unsigned int level);
 
 #endif /* DSFOREST_H */
@@ -0,0 +1,45 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "../clique_file.h"
+
+/*
+ * Convert a text list of maximal cliques, in the format read by 2012-ParCPM,
+ * into the binary format described in clique_file.h, which 2012-ParCPM maps
+ * in memory rather than parsing it.
+ */
+
+static void usage(const char *progname);
+
+int main(int argc, char **argv){
+  clique_file f;
+  int ret;
+
+  if (argc != 3) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if ((ret = clique_file_convert(argv[1], argv[2])) != 0) {
+    printf("Unable to convert %s into %s (error %i)... exiting.\n", argv[1], argv[2], ret);
+    return EXIT_FAILURE;
+  }
+
+  if (clique_file_map(&f, argv[2]) != 0) {
+    printf("Unable to read back %s... exiting.\n", argv[2]);
+    return EXIT_FAILURE;
+  }
+  printf("Maximal cliques:\t%llu\n", (unsigned long long)f.header->num_cliques);
+  printf("Largest clique:\t%u\n", f.header->k_max);
+  printf("Nodes:\t%u\n", f.header->num_nodes);
+  clique_file_unmap(&f);
+  return EXIT_SUCCESS;
+}
+
+static void usage(const char *progname){
+  printf("Usage:\n");
+  printf("%s <mxcliques_file> <binary_file>\n\n", progname);
+  printf("Where:\n");
+  printf(" <mxcliques_file>  A file containing a list of maximal cliques, one per line, each ending\n"
+         "                   with -1 or with the end of the line. Cliques with less than 3 nodes are dropped.\n");
+  printf(" <binary_file>     The binary file to be written.\n");
+}
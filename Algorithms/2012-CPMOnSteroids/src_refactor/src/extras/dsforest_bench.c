@@ -0,0 +1,208 @@
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <time.h>
+#include "../clique_file.h"
+#include "../cliques.h"
+#include "../dsforest.h"
+
+/*
+ * Throughput of the disjoint sets forest used by COS, for an increasing number
+ * of threads. The unions come from a maximal cliques file: for each k, every
+ * maximal clique with at least k nodes is merged with the previous such clique
+ * sharing a node with it. The same unions are done in three ways: without locks,
+ * as COS does now; with the mutex of the k taken around every union; and as COS
+ * did before, in a private forest for each thread, which is merged into the
+ * shared forest of each k under its mutex once the thread is done with that k.
+ */
+
+static cliques *all_cliques;
+static dsforest_t *dsf;
+static pthread_mutex_t *level_mutexes;
+static int num_threads;
+
+enum bench_mode { LOCK_FREE, LOCK_PER_UNION, PRIVATE_FOREST, NUM_MODES };
+static enum bench_mode mode;
+
+struct bench_thread_data {
+  int first_node;
+  unsigned long int unions;
+};
+
+/*
+ * Merge the private forest of a thread into the shared forest of level k, as
+ * community_thread_epilogue did: every non-root is joined with its root.
+ */
+static void merge_private_forest(dsforest_t *private_dsf, int k, unsigned long int rows_to_be_read){
+  unsigned long int i;
+  int root_i;
+
+  pthread_mutex_lock(&level_mutexes[k-3]);
+  for (i = 0; i < rows_to_be_read; i++) {
+    root_i = dsforest_find(private_dsf, 0, i);
+    if (root_i != (int)i)
+      dsforest_union(dsf, k-3, i, root_i);
+  }
+  pthread_mutex_unlock(&level_mutexes[k-3]);
+}
+
+static void bench_thread_body(void *params){
+  struct bench_thread_data *btd = (struct bench_thread_data*)params;
+  unsigned long int rows_to_be_read, n;
+  dsforest_t *private_dsf = NULL;
+  int u, k, previous;
+
+  btd->unions = 0;
+  // the unions made at some k also hold for all the smaller ones, so a
+  // private forest is kept from one k to the next, as COS did
+  if (mode == PRIVATE_FOREST)
+    dsforest_init(&private_dsf, 1, &all_cliques->maximal_cliques_total);
+  for (k = all_cliques->k_max; k >= 3; k--) {
+    cliques_rows_to_be_read(all_cliques, k, &rows_to_be_read);
+    for (u = btd->first_node; u < all_cliques->num_nodes; u += num_threads) {
+      previous = -1;
+      // the cliques of each node are in increasing order
+      for (n = all_cliques->node_offsets[u]; n < all_cliques->node_offsets[u+1]; n++) {
+        if (all_cliques->node_cliques[n] >= rows_to_be_read)
+          break;
+        if (previous >= 0) {
+          if (mode == PRIVATE_FOREST) {
+            dsforest_union(private_dsf, 0, previous, all_cliques->node_cliques[n]);
+          } else {
+            if (mode == LOCK_PER_UNION)
+              pthread_mutex_lock(&level_mutexes[k-3]);
+            dsforest_union(dsf, k-3, previous, all_cliques->node_cliques[n]);
+            if (mode == LOCK_PER_UNION)
+              pthread_mutex_unlock(&level_mutexes[k-3]);
+          }
+          btd->unions++;
+        }
+        previous = all_cliques->node_cliques[n];
+      }
+    }
+    if (mode == PRIVATE_FOREST)
+      merge_private_forest(private_dsf, k, rows_to_be_read);
+  }
+  if (private_dsf != NULL)
+    dsforest_destroy(private_dsf);
+  pthread_exit(NULL);
+}
+
+static double run(struct bench_thread_data *btd, unsigned long int *unions){
+  pthread_t *threads;
+  struct timespec start, end;
+  int i;
+
+  dsforest_clear(dsf);
+  threads = (pthread_t*)malloc(sizeof(pthread_t) * num_threads);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (i = 0; i < num_threads; i++) {
+    btd[i].first_node = i;
+    pthread_create(&threads[i], NULL, (void*)(&bench_thread_body), (void*)(&btd[i]));
+  }
+  *unions = 0;
+  for (i = 0; i < num_threads; i++) {
+    pthread_join(threads[i], NULL);
+    *unions += btd[i].unions;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  free(threads);
+  return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+static unsigned long int count_sets(unsigned int level){
+  unsigned long int i, sets = 0;
+  for (i = 0; i < dsforest_level_size(dsf, level); i++)
+    if (dsforest_is_root(dsf, level, i))
+      sets++;
+  return sets;
+}
+
+static void usage(const char *progname){
+  printf("Usage:\n");
+  printf("%s [-P <max_threads>] [-r <repetitions>] <mxcliques_file>\n\n", progname);
+  printf("Where:\n");
+  printf(" -P <max_threads>  Run with 1, 2, 4, ... up to <max_threads> threads. Default value is 8.\n");
+  printf(" -r <repetitions>  Keep the best time of <repetitions> runs. Default value is 3.\n");
+  printf(" <mxcliques_file>  A list of maximal cliques in the format read by 2012-ParCPM, text or binary.\n");
+}
+
+int main(int argc, char **argv){
+  struct bench_thread_data *btd;
+  unsigned long int *level_sizes, unions, sets = 0;
+  double seconds, best[NUM_MODES];
+  int max_threads = 8, repetitions = 3;
+  int c, k, r;
+
+  while ((c = getopt(argc, argv, "P:r:h")) != -1) {
+    switch (c) {
+    case 'P':
+      max_threads = atoi(optarg);
+      break;
+    case 'r':
+      repetitions = atoi(optarg);
+      break;
+    default:
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (optind != argc-1 || max_threads < 1 || repetitions < 1) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  cliques_init(&all_cliques);
+  if (clique_file_is_binary(argv[optind]))
+    c = cliques_load_binary_maximal_cliques_list(all_cliques, argv[optind]);
+  else
+    c = cliques_load_unordered_maximal_cliques_list(all_cliques, argv[optind]);
+  if (c != 0 || all_cliques->k_max < 3) {
+    printf("Unable to load maximal cliques with at least 3 nodes from %s... exiting.\n", argv[optind]);
+    return EXIT_FAILURE;
+  }
+  printf("Maximal cliques:\t%lu\n", all_cliques->maximal_cliques_total);
+  printf("Nodes:\t%i\n", all_cliques->num_nodes);
+
+  level_sizes = (unsigned long int*)malloc(sizeof(unsigned long int) * (all_cliques->k_max - 2));
+  level_mutexes = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t) * (all_cliques->k_max - 2));
+  for (k = 3; k <= all_cliques->k_max; k++) {
+    cliques_rows_to_be_read(all_cliques, k, &level_sizes[k-3]);
+    pthread_mutex_init(&level_mutexes[k-3], NULL);
+  }
+  dsforest_init(&dsf, all_cliques->k_max - 2, level_sizes);
+  btd = (struct bench_thread_data*)malloc(sizeof(struct bench_thread_data) * max_threads);
+
+  printf("threads\tunions\tlock-free s\tlock-free Munions/s\tlock per union s\tlock per union Munions/s\tprivate forest s\tprivate forest Munions/s\t3-sets\n");
+  for (num_threads = 1; ; num_threads *= 2) {
+    if (num_threads > max_threads)
+      num_threads = max_threads;
+    for (mode = LOCK_FREE; mode < NUM_MODES; mode++) {
+      best[mode] = -1;
+      for (r = 0; r < repetitions; r++) {
+        seconds = run(btd, &unions);
+        if (best[mode] < 0 || seconds < best[mode])
+          best[mode] = seconds;
+      }
+      // all the ways must find the same sets
+      if (mode == LOCK_FREE)
+        sets = count_sets(0);
+      else if (count_sets(0) != sets)
+        printf("The sets of mode %i differ from the lock-free ones!\n", mode);
+    }
+    printf("%i\t%lu\t%.3f\t%.1f\t%.3f\t%.1f\t%.3f\t%.1f\t%lu\n", num_threads, unions,
+           best[LOCK_FREE], unions / best[LOCK_FREE] / 1e6, best[LOCK_PER_UNION], unions / best[LOCK_PER_UNION] / 1e6,
+           best[PRIVATE_FOREST], unions / best[PRIVATE_FOREST] / 1e6, sets);
+    if (num_threads == max_threads)
+      break;
+  }
+
+  for (k = 3; k <= all_cliques->k_max; k++)
+    pthread_mutex_destroy(&level_mutexes[k-3]);
+  dsforest_destroy(dsf);
+  free(level_mutexes);
+  free(level_sizes);
+  free(btd);
+  return EXIT_SUCCESS;
+}
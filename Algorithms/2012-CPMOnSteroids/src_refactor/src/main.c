@@ -5,6 +5,7 @@
 #include <pthread.h>
 #include <errno.h>
 #include "cliques.h"
+#include "clique_file.h"
 #include "dsforest.h"
 #include "cos.h"
 #include "cospoc.h"
@@ -12,8 +13,7 @@
 
 cliques* all_cliques;
 int k_max;
-dsforest_t **global_dsf;
-pthread_mutex_t *global_dsf_mutexes;
+dsforest_t *global_dsf;
 int NUM_THREADS = 8;			// Number of parallel threads
 unsigned long int WINDOW_SIZE = 1ULL<<30; // sliding window size
 int debug_level=0;
@@ -64,7 +64,13 @@ int main(int argc, char** argv) {
   cliquelist_file = argv[argc-1];
 
   cliques_init(&all_cliques);
-  cliques_load_unordered_maximal_cliques_list(all_cliques, cliquelist_file);
+  if (clique_file_is_binary(cliquelist_file)) {
+    if (cliques_load_binary_maximal_cliques_list(all_cliques, cliquelist_file) != 0) {
+      printf("Unable to load maximal cliques with at least 3 nodes from %s... exiting.\n", cliquelist_file);
+      return(EXIT_FAILURE);
+    }
+  } else
+    cliques_load_unordered_maximal_cliques_list(all_cliques, cliquelist_file);
   k_max=all_cliques->k_max;
 
 
@@ -126,7 +132,9 @@ static void usage(const char* progname){
   printf(" <mxcliques_file>  A file containing a list of maximal cliques, one per line. Each maximal\n"
          "                   clique must be expressed as a whitespace-separated list of its nodes \n"
          "                   and must end with a virtual node -1. Nodes must be expressed as non-negative\n"
-         "                   integer numbers.\n");
+         "                   integer numbers.\n"
+         "                   The file can also be a binary list of maximal cliques written by\n"
+         "                   cliques-to-binary, which is mapped in memory rather than parsed.\n");
 
   printf("\n");
   printf("Output:\n");
@@ -159,6 +159,13 @@ int matrix_get(const matrix *m, int i, int j, uint8_t *value){
     return 0;
 }
 
+int matrix_get_row(const matrix *m, int i, uint8_t **row){
+    if(i<m->starts_at || i>m->ends_at)
+        return E_ROW_OUT_OF_WINDOW;
+    *row = m->begin_of_row[i - m->starts_at];
+    return 0;
+}
+
 int matrix_row_in_window(const matrix *m, int i){
     return (i>=m->starts_at && i<=m->ends_at) ? TRUE : FALSE;
 }
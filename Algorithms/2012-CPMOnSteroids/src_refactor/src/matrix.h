@@ -73,6 +73,12 @@ extern "C" {
    */
   int matrix_get(const matrix *m, int i, int j, uint8_t *value);
 
+  /*
+   * place in *row the address of the element at the i-th row and (i+1)-th
+   * column. The elements of the row, up to the last column, follow it
+   */
+  int matrix_get_row(const matrix *m, int i, uint8_t **row);
+
   /*
    * returns TRUE if the j-th row is in the window. It is good to call
    * this function before inserting values with the matrix_set. In this way
@@ -6,7 +6,7 @@
 
 extern cliques *all_cliques;
 extern int k_max;
-extern dsforest_t **global_dsf;
+extern dsforest_t *global_dsf;
 
 static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -19,7 +19,7 @@ static int write_found_communities_to_file_thread(void *k_param){
   char k_file_name[2048];
   FILE *k_communities_file,*k_num_com;
   int root_comm;
-  igraph_vector_t *current_clique;
+  const int *current_clique;
   long unsigned int rows_to_be_read;
 
   k = (intptr_t)k_param;
@@ -43,7 +43,7 @@ static int write_found_communities_to_file_thread(void *k_param){
     community_ids[j] = NO_COMMUNITY_ID_YET;
 
   for (j = 0; j < rows_to_be_read; j++) {
-    root_comm = dsforest_find(global_dsf[k-3], j);
+    root_comm = dsforest_find(global_dsf, k-3, j);
 
     if(community_ids[root_comm] == NO_COMMUNITY_ID_YET){
       community_ids[root_comm] = comm_id++;
@@ -55,7 +55,7 @@ static int write_found_communities_to_file_thread(void *k_param){
 
     fprintf(k_communities_file, "%i:", this_comm_id);
     for (z = 0; z < current_clique_size; z++)
-      fprintf(k_communities_file, "%i ", (int)VECTOR(*current_clique)[z]);
+      fprintf(k_communities_file, "%i ", current_clique[z]);
     fprintf(k_communities_file, "\n");
   }
   fclose(k_communities_file);	
@@ -76,6 +76,25 @@ static int write_found_communities_to_file_thread(void *k_param){
   return 0;
 }
 
+/*
+ * allocate the global disjoint set forest, with a level for each k between 3
+ * and k_max. The level of k holds the maximal cliques which can belong to a
+ * k-clique community, i.e. the ones with at least k nodes
+ */
+int init_found_communities(){
+  unsigned long int *disjoint_sets_numbers;
+  int k, ret;
+
+  disjoint_sets_numbers = (unsigned long int*)malloc(sizeof(unsigned long int) * (k_max - 2));
+  if (disjoint_sets_numbers == NULL)
+    return -1;
+  for (k = 3; k <= k_max; k++)
+    cliques_rows_to_be_read(all_cliques, k, &disjoint_sets_numbers[k-3]);
+  ret = dsforest_init(&global_dsf, k_max - 2, disjoint_sets_numbers);
+  free(disjoint_sets_numbers);
+  return ret;
+}
+
 int write_found_communities_to_file(){
   // THREADS
   pthread_t* output_threads = NULL;		    // constructor threads
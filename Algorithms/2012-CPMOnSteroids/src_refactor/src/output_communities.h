@@ -3,6 +3,7 @@
 
 #include "dsforest.h"
 
+extern int init_found_communities();
 extern int write_found_communities_to_file();
 
 #endif /* OUTPUT_COMMUNITIES_H */
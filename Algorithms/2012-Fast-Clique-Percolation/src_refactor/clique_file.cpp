@@ -0,0 +1,90 @@
+#include "clique_file.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cliques {
+
+static const char MAGIC[8] = { 'M', 'X', 'C', 'L', 'Q', 'B', 'I', 'N' };
+
+bool CliqueFile :: isCliqueFile(const char * fileName) {
+	char magic[8];
+	std :: ifstream in(fileName, std :: ios :: binary);
+	return in.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(magic)) == 0;
+}
+
+CliqueFile :: CliqueFile(const char * fileName) : map(MAP_FAILED), map_size(0) {
+	const int fd = open(fileName, O_RDONLY);
+	if (fd < 0)
+		throw std :: runtime_error(std :: string("cannot open ") + fileName);
+	struct stat st;
+	if (fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(Header)) {
+		map_size = st.st_size;
+		map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	if (map == MAP_FAILED)
+		throw std :: runtime_error(std :: string("cannot map ") + fileName);
+
+	const char * base = static_cast<const char *>(map);
+	header = reinterpret_cast<const Header *>(base);
+	// bound the counts by the file size first, so that the size computed from them cannot overflow
+	const bool sizesFit = memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+		&& header->k_max < map_size / sizeof(uint64_t)
+		&& header->num_cliques < map_size / sizeof(uint64_t)
+		&& header->num_entries < map_size / sizeof(int32_t)
+		&& sizeof(Header) + sizeof(uint64_t) * (header->k_max + 1 + header->num_cliques + 1)
+			+ sizeof(int32_t) * header->num_entries == map_size;
+	if (sizesFit) {
+		k_counts = reinterpret_cast<const uint64_t *>(base + sizeof(Header));
+		offsets = k_counts + header->k_max + 1;
+		nodes = reinterpret_cast<const int32_t *>(offsets + header->num_cliques + 1);
+	}
+	if (! sizesFit || ! consistent()) {
+		munmap(map, map_size);
+		throw std :: runtime_error(std :: string("not a binary clique file: ") + fileName);
+	}
+}
+
+bool CliqueFile :: consistent() const {
+	// the groups of k_counts cover all the cliques, and there are none with less than 3 nodes
+	uint64_t total = 0;
+	for (uint32_t k = 0; k <= header->k_max; ++k) {
+		if ((k < 3 && k_counts[k] != 0) || k_counts[k] > header->num_cliques - total)
+			return false;
+		total += k_counts[k];
+	}
+	if (total != header->num_cliques || offsets[0] != 0)
+		return false;
+	// every clique of a group has the size of the group, and they end with the nodes table
+	uint64_t c = 0;
+	for (uint32_t k = header->k_max; k >= 3; --k)
+		for (uint64_t i = 0; i < k_counts[k]; ++i, ++c)
+			if (offsets[c] > header->num_entries || offsets[c+1] - offsets[c] != k)
+				return false;
+	if (offsets[header->num_cliques] != header->num_entries)
+		return false;
+	for (uint64_t n = 0; n < header->num_entries; ++n)
+		if (nodes[n] < 0 || uint32_t(nodes[n]) >= header->num_nodes)
+			return false;
+	return true;
+}
+
+CliqueFile :: ~ CliqueFile() {
+	munmap(map, map_size);
+}
+
+int64_t CliqueFile :: countAtLeast(unsigned int k) const {
+	int64_t count = 0;
+	for (unsigned int size = header->k_max; size >= k && size > 0; --size)
+		count += k_counts[size];
+	return count;
+}
+
+} // namespace cliques
@@ -0,0 +1,53 @@
+#ifndef _CLIQUE_FILE_HPP_
+#define _CLIQUE_FILE_HPP_
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace cliques {
+
+// Read-only, memory-mapped view of a binary maximal cliques file, as written by cliques-to-binary of
+// 2012-CPMOnSteroids (see clique_file.h there for the layout). The cliques are grouped by size, largest first,
+// and the nodes of each clique are sorted, so the cliques with at least k nodes are the first countAtLeast(k).
+class CliqueFile {
+public:
+	static bool isCliqueFile(const char * fileName); // checks the magic bytes at the start of the file
+
+	explicit CliqueFile(const char * fileName); // throws std :: runtime_error
+	~ CliqueFile();
+
+	int64_t size() const { return header->num_cliques; }
+	int64_t countAtLeast(unsigned int k) const;
+	unsigned int kMax() const { return header->k_max; }
+	int32_t numNodes() const { return header->num_nodes; }
+	const int32_t * begin(int64_t clique) const { return nodes + offsets[clique]; }
+	const int32_t * end  (int64_t clique) const { return nodes + offsets[clique+1]; }
+	// the whole tables, clique c is allNodes()[allOffsets()[c]] ... allNodes()[allOffsets()[c+1]-1]
+	const int32_t * allNodes() const { return nodes; }
+	const uint64_t * allOffsets() const { return offsets; }
+
+private:
+	struct Header {
+		char magic[8];
+		uint32_t k_max;
+		uint32_t num_nodes;
+		uint64_t num_cliques;
+		uint64_t num_entries;
+	};
+
+	CliqueFile(const CliqueFile &);
+	CliqueFile & operator = (const CliqueFile &);
+
+	bool consistent() const; // the tables agree with each other and with the header
+
+	void * map;
+	size_t map_size;
+	const Header * header;
+	const uint64_t * k_counts;
+	const uint64_t * offsets;
+	const int32_t * nodes;
+};
+
+} // namespace cliques
+
+#endif
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <limits>
 #include <sys/stat.h>
+#include <omp.h>
 #include "pp.hpp"
 
 using namespace std;
@@ -250,6 +251,17 @@ namespace cliques {
     struct SelfLoopsNotSupportedException {
     };
 
+    // Keeps the cliques found by one thread, one after the other, until they can be sent on in order.
+    struct CliquesOfOneThread : public CliqueReceiver {
+        vector<V> nodes;
+        vector<size_t> ends; // clique c is nodes[ends[c-1]] ... nodes[ends[c]-1]
+
+        virtual void operator()(const std::vector<V> &clique) {
+            nodes.insert(nodes.end(), clique.begin(), clique.end());
+            ends.push_back(nodes.size());
+        }
+    };
+
     static void findCliques(const SimpleIntGraph &g, CliqueReceiver *send_cliques_here, unsigned int minimumSize) {
         unless(minimumSize >= 3) throw std::invalid_argument("the minimumSize for findCliques() must be at least 3");
 
@@ -259,10 +271,34 @@ namespace cliques {
                 throw SelfLoopsNotSupportedException();
         }
 
-        for (V v = 0; v < (V) g->numNodes(); v++) {
-            if (v && v % 100 == 0)
+        // The search from each node is independent of the others and only reads the graph. Threads take the nodes
+        // one at a time, as they become free, and keep what they find; the cliques are then sent on node by node,
+        // so send_cliques_here gets them in the same order as from a single thread.
+        const V N = g->numNodes();
+        vector<CliquesOfOneThread> found(omp_get_max_threads());
+        vector<int> threadOfNode(N);
+        vector<size_t> firstOfNode(N), lastOfNode(N);
+
+#pragma omp parallel for schedule(dynamic, 1)
+        for (V v = 0; v < N; v++) {
+            if (v && v % 100 == 0) {
+#pragma omp critical
                 cerr << "processing node: " << v << " ..." << endl;
-            cliquesForOneNode(g, send_cliques_here, minimumSize, v);
+            }
+            CliquesOfOneThread &mine = found[omp_get_thread_num()];
+            threadOfNode[v] = omp_get_thread_num();
+            firstOfNode[v] = mine.ends.size();
+            cliquesForOneNode(g, &mine, minimumSize, v);
+            lastOfNode[v] = mine.ends.size();
+        }
+
+        vector<V> clique;
+        for (V v = 0; v < N; v++) {
+            const CliquesOfOneThread &theirs = found[threadOfNode[v]];
+            for (size_t c = firstOfNode[v]; c < lastOfNode[v]; c++) {
+                clique.assign(theirs.nodes.begin() + (c ? theirs.ends[c - 1] : 0), theirs.nodes.begin() + theirs.ends[c]);
+                send_cliques_here->operator()(clique);
+            }
         }
     }
 
@@ -1,5 +1,4 @@
 #include "bloom.hpp"
-#include <tr1/unordered_set>
 #include "../pp.hpp"
 namespace graph {
 namespace bloom {
@@ -8,24 +7,15 @@ namespace bloom {
 BloomAreConnected :: BloomAreConnected ( const VerySimpleGraphInterface * vsg ) {
 	assert(vsg);
 	const int32_t R = vsg->numRels();
-	const size_t sz = 10 * R; // was 100, now just 10, so as to run on the Idiro machine :-(
-	assert(this->bloom.size()==0);
-	this->bloom.resize(sz);
-	assert(this->bloom.size()==sz);
-	// PP2(R,sz);
-	int num_trues = 0;
-	int num_clashes = 0;
+	size_t sz = 64;
+	while(sz < 10 * size_t(R)) // was 100, now just 10, so as to run on the Idiro machine :-(
+		sz *= 2;
+	this->words.assign(sz / 64, 0);
+	this->mask = sz - 1;
 	for(int r=0; r<R;r++) {
-		size_t h = this->hash(vsg, r);
-		// PP2(r, h);
-		if(!this->bloom.at(h % bloom.size()))
-			++ num_trues;
-		else
-			++ num_clashes;
-		this->bloom.at(h % bloom.size()) = true;
+		const size_t bit = this->hash(vsg, r) & this->mask;
+		this->words[bit >> 6] |= uint64_t(1) << (bit & 63);
 	}
-	// std :: cerr << "num_trues " << num_trues << std :: endl;
-	// std :: cerr << "num_clashes " << num_clashes << std :: endl;
 }
 size_t BloomAreConnected :: hash( const VerySimpleGraphInterface * vsg, const int32_t rel_id )  const {
 	assert(vsg);
@@ -33,17 +23,18 @@ size_t BloomAreConnected :: hash( const VerySimpleGraphInterface * vsg, const in
 	const std :: pair<int32_t, int32_t> & eps = vsg->EndPoints(rel_id);
 	assert(eps.first <= eps.second);
 	return this -> hash(eps.first, eps.second);
-	// return std :: tr1 :: hash<int>()(eps.first) ^ std :: tr1 :: hash<int>()(-eps.second);
 }
 size_t BloomAreConnected :: hash( int32_t node_id_1, int32_t node_id_2)  const {
 	if(node_id_1 > node_id_2) {
 		std :: swap(node_id_1, node_id_2);
 	}
 	assert(node_id_1 <= node_id_2);
-	// PP3  ( std :: tr1 :: hash<int>()(node_id_1) , std :: tr1 :: hash<int>()(-node_id_2), std :: tr1 :: hash<int>()(node_id_1) ^ std :: tr1 :: hash<int>()(-node_id_2) );
-	return node_id_1 - 100000 * node_id_2;
+	// mix both ids into all the bits, since only the low ones are kept
+	uint64_t h = (uint64_t(uint32_t(node_id_1)) << 32) | uint32_t(node_id_2);
+	h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+	return size_t(h ^ (h >> 31));
 }
 
 } // namespace bloom
 } // namespace graph
-
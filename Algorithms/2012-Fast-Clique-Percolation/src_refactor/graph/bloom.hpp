@@ -3,20 +3,24 @@
 namespace graph {
 namespace bloom {
 // a Bloom filter to speed up VerySimpleGraphInterface :: are_connected(int32_t node_id_1, int32_t node_id_2)
+// The bits are packed in 64-bit words and there is a power of two of them, so a test is a shift and a mask.
+// The filter is only read once built, so any number of threads can test it at once.
 
 class BloomAreConnected;
 
 class BloomAreConnected {
 public:
-	std :: vector<bool> bloom;
 	BloomAreConnected ( const graph :: VerySimpleGraphInterface * vsg );
 	size_t hash( const graph :: VerySimpleGraphInterface * vsg, const int32_t rel_id ) const ;
 	size_t hash( int32_t node_id_1, int32_t node_id_2 ) const ;
 	bool test( const int32_t node_id_1, const int32_t node_id_2 ) const {
-		return this->bloom.at( this->hash(node_id_1, node_id_2) % bloom.size() );
+		const size_t bit = this->hash(node_id_1, node_id_2) & this->mask;
+		return (this->words[bit >> 6] >> (bit & 63)) & 1;
 	}
+private:
+	std :: vector<uint64_t> words;
+	size_t mask; // number of bits - 1
 };
 
 } // namespace bloom
 } // namespace graph
-
@@ -0,0 +1,202 @@
+using namespace std;
+#include "percolateAllK.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "graph/network.hpp"
+#include "graph/loading.hpp"
+#include "pp.hpp"
+#include "cliques.hpp"
+#include "clique_file.hpp"
+
+namespace {
+
+// Union-find over the cliques; the root with the greater id is linked under the other one.
+struct CliqueSets {
+	vector<int> parent;
+
+	explicit CliqueSets(int size) : parent(size) {
+		for (int i = 0; i < size; ++i)
+			parent[i] = i;
+	}
+	int find(int x) {
+		while (parent[x] != x) {
+			parent[x] = parent[parent[x]];
+			x = parent[x];
+		}
+		return x;
+	}
+	void merge(int x, int y) {
+		x = find(x);
+		y = find(y);
+		if (x < y)
+			parent[y] = x;
+		else if (y < x)
+			parent[x] = y;
+	}
+};
+
+// The maximal cliques with at least 3 nodes, by decreasing size, so that those with at least k nodes come first.
+// Clique c is nodes[offsets[c]] ... nodes[offsets[c+1]-1], sorted. The tables are those of the mapped clique file
+// when the cliques come from one, and foundNodes and foundOffsets when they were found in an edge list.
+struct SortedCliques {
+	const int32_t * nodes;
+	const uint64_t * offsets;
+	int numCliques;
+	int maxNode;
+
+	unique_ptr<cliques :: CliqueFile> file;
+	vector<int32_t> foundNodes;
+	vector<uint64_t> foundOffsets;
+
+	int size() const { return numCliques; }
+	int64_t numEntries() const { return offsets[numCliques]; }
+	int cliqueSize(int c) const { return offsets[c+1] - offsets[c]; }
+	int countAtLeast(int k) const { // the cliques are sorted by decreasing size
+		int lo = 0, hi = size();
+		while (lo < hi) {
+			const int mid = lo + (hi - lo) / 2;
+			if (cliqueSize(mid) >= k)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+};
+
+void findSortedCliques(SortedCliques &sorted, const char * edgeListFileName) {
+	if (cliques :: CliqueFile :: isCliqueFile(edgeListFileName)) {
+		// already in the right order, the cliques are used where they are mapped
+		sorted.file.reset(new cliques :: CliqueFile(edgeListFileName));
+		sorted.nodes = sorted.file->allNodes();
+		sorted.offsets = sorted.file->allOffsets();
+		sorted.numCliques = sorted.file->countAtLeast(3);
+		sorted.maxNode = sorted.file->numNodes() - 1;
+		return;
+	}
+
+	vector< vector<int64_t> > all_cliques_by_orig_name;
+	{
+		unique_ptr<graph :: NetworkInterfaceConvertedToString > network(graph :: loading :: make_Network_from_edge_list_int64(edgeListFileName, 0, 0).release());
+		cliques :: cliquesToVector(all_cliques_by_orig_name, network.get(), 3);
+	}
+	vector<int> order(all_cliques_by_orig_name.size());
+	for (size_t c = 0; c < order.size(); ++c)
+		order[c] = c;
+	stable_sort(order.begin(), order.end(), [&all_cliques_by_orig_name](int a, int b) {
+		return all_cliques_by_orig_name[a].size() > all_cliques_by_orig_name[b].size();
+	});
+	sorted.foundNodes.clear();
+	sorted.foundOffsets.assign(1, 0);
+	sorted.maxNode = -1;
+	for (size_t c = 0; c < order.size(); ++c) {
+		vector<int64_t> &one_clique = all_cliques_by_orig_name[order[c]];
+		sort(one_clique.begin(), one_clique.end());
+		for (size_t n = 0; n < one_clique.size(); ++n) {
+			sorted.foundNodes.push_back(one_clique[n]);
+			sorted.maxNode = max(sorted.maxNode, int(one_clique[n]));
+		}
+		sorted.foundOffsets.push_back(sorted.foundNodes.size());
+	}
+	sorted.nodes = sorted.foundNodes.data();
+	sorted.offsets = sorted.foundOffsets.data();
+	sorted.numCliques = order.size();
+}
+
+void writeCommunities(const SortedCliques &sorted, CliqueSets &sets, const int k, const string &fileName) {
+	const int count = sorted.countAtLeast(k);
+
+	// communities numbered by their first clique, as percolateCliques does
+	vector<int> communityOfRoot(count, -1);
+	vector< vector<int> > communities;
+	for (int c = 0; c < count; ++c) {
+		const int root = sets.find(c);
+		if (communityOfRoot[root] < 0) {
+			communityOfRoot[root] = communities.size();
+			communities.push_back(vector<int>());
+		}
+		vector<int> &community = communities[communityOfRoot[root]];
+		community.insert(community.end(), sorted.nodes + sorted.offsets[c], sorted.nodes + sorted.offsets[c+1]);
+	}
+
+	ofstream myfile(fileName.c_str());
+	for (size_t i = 0; i < communities.size(); ++i) {
+		sort(communities[i].begin(), communities[i].end());
+		communities[i].erase(unique(communities[i].begin(), communities[i].end()), communities[i].end());
+		for (size_t n = 0; n < communities[i].size(); ++n)
+			myfile << communities[i][n] << " ";
+		myfile << endl;
+	}
+}
+
+} // namespace
+
+void percolateCliquesAllK(const char * edgeListFileName, const int kMin, const int kMax, const char * outFileName) {
+	SortedCliques sorted;
+	findSortedCliques(sorted, edgeListFileName);
+	const int numCliques = sorted.size();
+	PP(numCliques);
+	const int largest = numCliques ? sorted.cliqueSize(0) : 0;
+
+	//node -> the cliques it is in, in increasing order
+	vector<int64_t> nodeOffsets(sorted.maxNode + 2, 0);
+	for (int64_t n = 0; n < sorted.numEntries(); ++n)
+		++nodeOffsets[sorted.nodes[n] + 1];
+	for (int u = 0; u <= sorted.maxNode; ++u)
+		nodeOffsets[u+1] += nodeOffsets[u];
+	vector<int> nodeCliques(sorted.numEntries());
+	{
+		vector<int64_t> next(nodeOffsets.begin(), nodeOffsets.end() - 1);
+		for (int c = 0; c < numCliques; ++c)
+			for (uint64_t n = sorted.offsets[c]; n < sorted.offsets[c+1]; ++n)
+				nodeCliques[next[sorted.nodes[n]]++] = c;
+	}
+
+	//one union-find for each k, sets[k] over the cliques with at least k nodes
+	vector<CliqueSets> sets;
+	for (int k = 0; k <= largest; ++k)
+		sets.push_back(CliqueSets(k >= 3 ? sorted.countAtLeast(k) : 0));
+
+	cout << "Setup complete, about to percolate found cliques." << endl;
+	vector<int> overlap(numCliques, 0);
+	vector<int> touched;
+	for (int c = 0; c < numCliques; ++c) {
+		//count the nodes shared with every later clique
+		for (uint64_t n = sorted.offsets[c]; n < sorted.offsets[c+1]; ++n) {
+			const int u = sorted.nodes[n];
+			for (vector<int> :: const_iterator other = upper_bound(nodeCliques.begin() + nodeOffsets[u], nodeCliques.begin() + nodeOffsets[u+1], c);
+					other != nodeCliques.begin() + nodeOffsets[u+1]; ++other) {
+				if (overlap[*other]++ == 0)
+					touched.push_back(*other);
+			}
+		}
+		//two maximal cliques share less nodes than the smaller one has, so both are in sets[overlap + 1]; a clique
+		//file may still repeat a clique or hold one inside another, then they share all of the later one
+		for (size_t t = 0; t < touched.size(); ++t) {
+			if (overlap[touched[t]] >= 2)
+				sets[min(overlap[touched[t]] + 1, sorted.cliqueSize(touched[t]))].merge(c, touched[t]);
+			overlap[touched[t]] = 0;
+		}
+		touched.clear();
+	}
+	for (int k = largest; k > 3; --k) {
+		for (int c = 0; c < int(sets[k].parent.size()); ++c)
+			sets[k-1].merge(c, sets[k].find(c));
+	}
+	cout << "Percolation complete" << endl;
+
+	for (int k = kMin; k <= kMax; ++k) {
+		ostringstream fileName;
+		fileName << outFileName << "." << k;
+		if (k <= largest)
+			writeCommunities(sorted, sets[k], k, fileName.str());
+		else
+			ofstream(fileName.str().c_str());
+	}
+}
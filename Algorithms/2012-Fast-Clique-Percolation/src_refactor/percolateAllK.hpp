@@ -0,0 +1,11 @@
+#ifndef _PERCOLATE_ALL_K_HPP_
+#define _PERCOLATE_ALL_K_HPP_
+
+// Finds the k-clique communities for every k from kMin to kMax in one pass over the maximal cliques, and writes
+// those of each k to outFileName.k, in the format of percolateCliques.
+// The cliques are found in the edge list, or taken from a binary clique file, only once. Each pair of cliques sharing
+// o >= 2 nodes is merged only in the union-find of k = o + 1, the largest k it percolates for, and then the sets of
+// each k are carried down to k - 1, since every (k+1)-clique community lies inside a k-clique community.
+void percolateCliquesAllK(const char * edgeListFileName, const int kMin, const int kMax, const char * outFileName);
+
+#endif
@@ -5,22 +5,51 @@ using namespace std;
 #include <unistd.h>
 #include <libgen.h>
 #include <ctime>
+#include <cstring>
+#include <algorithm>
 #include <vector>
 #include <set>
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <stdexcept>
 #include <tr1/unordered_set>
 #include <tr1/unordered_map>
 
 #include "pp.hpp"
 #include "cliques.hpp"
+#include "clique_file.hpp"
+#include "percolateAllK.hpp"
 #include "cmdline.h"
 
 int option_minCliqueSize = 3;
 
 void test_cliques_to_vector(const char * edgeListFileName, const int k);
 void percolateCliques(const char * edgeListFileName, const int k, const char * outFileName);
+template <class Cliques>
+void percolateFoundCliques(const Cliques &cliques, const int64_t maxId, const int k, const char * outFileName);
+
+//The cliques found in an edge list, each one a set of nodes.
+struct CliquesInMemory {
+    typedef set<int> :: const_iterator const_iterator;
+    const vector < set < int> > &cliques;
+
+    int size() const { return cliques.size(); }
+    const_iterator begin(int i) const { return cliques[i].begin(); }
+    const_iterator end(int i) const { return cliques[i].end(); }
+};
+
+//The cliques with at least k nodes of a binary clique file, which are the first ones in the file.
+//They are read where they are mapped, the nodes of each clique are sorted as in a set.
+struct CliquesInFile {
+    typedef const int32_t * const_iterator;
+    const cliques :: CliqueFile &file;
+    const int count;
+
+    int size() const { return count; }
+    const_iterator begin(int i) const { return file.begin(i); }
+    const_iterator end(int i) const { return file.end(i); }
+};
 
 int main(int argc, char **argv) {
 
@@ -28,6 +57,8 @@ int main(int argc, char **argv) {
     if (argc != 4)
     {
         cout << "Incorrect number of parameters! Usage: inputFileName, k, outputFileName" << endl;
+        cout << "inputFileName is an edge list, or a binary clique file written by cliques-to-binary of 2012-CPMOnSteroids" << endl;
+        cout << "k can also be a range kMin-kMax: the communities of every k in it are found at once and written to outputFileName.k" << endl;
 
         exit(1);
 
@@ -38,8 +69,23 @@ int main(int argc, char **argv) {
 
     const char * outFileName = argv[3];
 
-	percolateCliques(edgeListFileName, k, outFileName);
-    
+    const char * kMax = strchr(argv[2], '-');
+    // a binary clique file that is truncated or invalid can't be mapped
+    try
+    {
+        if (kMax != NULL)
+        {
+            percolateCliquesAllK(edgeListFileName, max(k, 3), atoi(kMax + 1), outFileName);
+            return 0;
+        }
+
+        percolateCliques(edgeListFileName, k, outFileName);
+    }
+    catch (const runtime_error &e)
+    {
+        cout << e.what() << endl;
+        exit(1);
+    }
 
 }
 
@@ -47,13 +93,23 @@ int main(int argc, char **argv) {
 
 void percolateCliques(const char * edgeListFileName, const int k, const char * outFileName) {
 
-    //First find the cliques
-	vector< vector<int64_t> > all_cliques_by_orig_name;
+    //First find the cliques, unless they have been found already and stored in a binary clique file
+    if (cliques :: CliqueFile :: isCliqueFile(edgeListFileName))
+    {
+        cliques :: CliqueFile cliqueFile(edgeListFileName);
+        const CliquesInFile cliquesInFile = { cliqueFile, int(cliqueFile.countAtLeast(k)) };
+        PP(cliquesInFile.size());
+        percolateFoundCliques(cliquesInFile, cliqueFile.numNodes() - 1, k, outFileName);
+        return;
+    }
 
-    std :: auto_ptr<graph :: NetworkInterfaceConvertedToString > network;
-	network = graph :: loading :: make_Network_from_edge_list_int64(edgeListFileName, 0, 0);
-	cliques :: cliquesToVector(all_cliques_by_orig_name, network.get(), k);
-	PP(all_cliques_by_orig_name.size());
+	vector< vector<int64_t> > all_cliques_by_orig_name;
+    {
+        std :: auto_ptr<graph :: NetworkInterfaceConvertedToString > network;
+        network = graph :: loading :: make_Network_from_edge_list_int64(edgeListFileName, 0, 0);
+        cliques :: cliquesToVector(all_cliques_by_orig_name, network.get(), k);
+        PP(all_cliques_by_orig_name.size());
+    }
 
 
 
@@ -73,6 +129,14 @@ void percolateCliques(const char * edgeListFileName, const int k, const char * o
         //Make a copy of the cliques; wasteful, but not a bottleneck, currently.
         cliques.push_back( set<int> ( one_clique->begin(), one_clique->end()));
 	}
+
+    const CliquesInMemory cliquesInMemory = { cliques };
+    percolateFoundCliques(cliquesInMemory, maxId, k, outFileName);
+}
+
+
+template <class Cliques>
+void percolateFoundCliques(const Cliques &cliques, const int64_t maxId, const int k, const char * outFileName) {
     cout << "Max Id: " << maxId << endl;
 
 
@@ -83,7 +147,7 @@ void percolateCliques(const char * edgeListFileName, const int k, const char * o
 
     for(int i = 0; i < cliques.size(); ++i) 
     {
-		for( set<int> :: const_iterator current_node = cliques[i].begin(); current_node != cliques[i].end(); ++current_node) 
+		for( typename Cliques :: const_iterator current_node = cliques.begin(i); current_node != cliques.end(i); ++current_node) 
         {
             
             if (nodesToCliques[*current_node] == NULL)
@@ -122,7 +186,7 @@ void percolateCliques(const char * edgeListFileName, const int k, const char * o
                 
 
                 //for each node in the current clique
-		        for( set<int> :: const_iterator current_node = cliques[currentClique].begin(); current_node != cliques[currentClique].end(); ++current_node) 
+		        for( typename Cliques :: const_iterator current_node = cliques.begin(currentClique); current_node != cliques.end(currentClique); ++current_node) 
                 {
                     //for this specific node, in the current clique, for each of the other cliques that the node is in.
                     for (set<int> :: const_iterator other_clique =  (nodesToCliques[*current_node])->begin(); other_clique != (nodesToCliques[*current_node])->end(); ++other_clique)
@@ -145,7 +209,7 @@ void percolateCliques(const char * edgeListFileName, const int k, const char * o
                         frontier.insert((*mapItr).first);
                         
                         //remove from nodesToCliques map
-                        for (set <int> :: const_iterator otherCliqueNodes = cliques[(*mapItr).first].begin(); otherCliqueNodes != cliques[(*mapItr).first].end(); ++otherCliqueNodes)
+                        for (typename Cliques :: const_iterator otherCliqueNodes = cliques.begin((*mapItr).first); otherCliqueNodes != cliques.end((*mapItr).first); ++otherCliqueNodes)
                         {
                             (nodesToCliques[*otherCliqueNodes])->erase((*mapItr).first);                
                         }
@@ -170,7 +234,7 @@ void percolateCliques(const char * edgeListFileName, const int k, const char * o
         int theComponent = (*cliquesToComponentsItr).second;
         
         
-        for ( set <int>::iterator cliqueItr = cliques[theClique].begin(); cliqueItr != cliques[theClique].end(); ++cliqueItr)
+        for ( typename Cliques :: const_iterator cliqueItr = cliques.begin(theClique); cliqueItr != cliques.end(theClique); ++cliqueItr)
         {
             componentsToNodes[theComponent].insert( *cliqueItr);
         }
@@ -195,4 +259,3 @@ void percolateCliques(const char * edgeListFileName, const int k, const char * o
 
     myfile.close();
 }
-